@@ -0,0 +1,70 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+#include "bench.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Every block carries its size in a header so operator delete
+// can account for it.
+constexpr std::size_t HEADER = alignof(std::max_align_t);
+
+// Atomic, since threaded benches allocate and free on several threads.
+// Relaxed is enough: the counters order nothing else.
+std::atomic<std::size_t> g_liveBytes{0};
+std::atomic<std::size_t> g_allocations{0};
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    void *p = std::malloc(size + HEADER);
+    if (p == nullptr)
+        throw std::bad_alloc();
+
+    *static_cast<std::size_t *>(p) = size;
+    g_liveBytes.fetch_add(size, std::memory_order_relaxed);
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<char *>(p) + HEADER;
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept {
+    if (p == nullptr)
+        return;
+
+    char *block = static_cast<char *>(p) - HEADER;
+    g_liveBytes.fetch_sub(*reinterpret_cast<std::size_t *>(block),
+                          std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete[](void *p) noexcept {
+    operator delete(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+namespace pone::bench {
+
+std::size_t liveBytes() {
+    return g_liveBytes.load(std::memory_order_relaxed);
+}
+
+std::size_t allocations() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+} // namespace pone::bench
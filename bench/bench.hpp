@@ -0,0 +1,82 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+namespace pone::bench {
+
+// +----------------------------------+
+// + Allocation counters              +
+// +----------------------------------+
+
+/**
+ * Gets the number of bytes currently allocated through
+ * the global operator new.
+ *
+ * @return the live heap bytes.
+ */
+std::size_t liveBytes();
+
+/**
+ * Gets the number of calls made to the global operator new.
+ *
+ * @return the number of allocations.
+ */
+std::size_t allocations();
+
+// +----------------------------------+
+// + Timing                           +
+// +----------------------------------+
+
+/**
+ * Wall clock stopwatch, started on construction.
+ */
+class Timer {
+    std::chrono::steady_clock::time_point m_start;
+
+  public:
+    /**
+     * Constructs and starts a timer.
+     */
+    Timer() : m_start{std::chrono::steady_clock::now()} {}
+
+    /**
+     * Gets the time elapsed since construction.
+     *
+     * @return the elapsed time in nanoseconds.
+     */
+    double ns() const {
+        return std::chrono::duration<double, std::nano>(
+                   std::chrono::steady_clock::now() - m_start)
+            .count();
+    }
+};
+
+/**
+ * Prints one benchmark result line.
+ *
+ * @param name the name of the measurement.
+ * @param value the measured value.
+ * @param unit the unit of the value.
+ */
+inline void report(const std::string &name, const double &value,
+                   const std::string &unit) {
+    std::cout << name << ": " << value << ' ' << unit << std::endl;
+}
+
+/**
+ * Keeps the optimizer from discarding a computed value.
+ *
+ * @param value the value to keep.
+ */
+template <typename T> inline void keep(const T &value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+} // namespace pone::bench
@@ -0,0 +1,150 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Compares pone::BitBoard against pone::Board on a 64 x 64 puzzle:
+// random walks through checkMove/moveCursor, color group rotations
+// and a full reachability flood fill from the cursor.
+
+#include "bench.hpp"
+#include "game/pone_bitboard.hpp"
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int SIZE = 64;
+constexpr int STEPS = 1000000;
+constexpr int ROTATIONS = 100000;
+constexpr int FILLS = 1000;
+
+const std::string COLORS[] = {"red", "green", "blue", "yellow"};
+const std::string TYPES[] = {"empty", "empty", "empty", "collision",
+                             "up",    "down",  "left",  "right"};
+
+Board makeBoard() {
+    std::mt19937 rng{7};
+    Board board{"bench", SIZE, SIZE};
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x)
+            board.add(std::make_shared<Tile>(
+                "t" + std::to_string(y * SIZE + x), y * SIZE + x + 1, x, y,
+                COLORS[rng() % 4], (x | y) ? TYPES[rng() % 8] : "empty",
+                false));
+
+    for (int y = 0; y + 1 < SIZE; ++y) {
+        for (int x = 0; x + 1 < SIZE; ++x) {
+            if (rng() % 8 == 0)
+                board.add(std::make_shared<Gate>(
+                    board.getTile(x, y), board.getTile(x + 1, y),
+                    "g" + std::to_string(y * SIZE + x), "red", true));
+        }
+    }
+
+    board.setCursorTile(board.getTile(0, 0));
+    return board;
+}
+
+/**
+ * Walks the cursor with random valid moves.
+ *
+ * @return the number of moves made.
+ */
+template <BoardBackend B> int walk(B &board) {
+    std::mt19937 rng{11};
+    int moves = 0;
+
+    for (int i = 0; i < STEPS; ++i) {
+        Direction d = static_cast<Direction>(rng() % 4);
+        if (board.checkMove(d)) {
+            board.moveCursor(d);
+            ++moves;
+        }
+    }
+
+    return moves;
+}
+
+/**
+ * Counts the cells reachable from the cursor with a breadth-first
+ * search over the Board query API.
+ */
+int floodFill(const Board &board) {
+    std::vector<char> seen(SIZE * SIZE, 0);
+    std::queue<TilePtr> queue;
+    TilePtr start = board.getCursorTile();
+    queue.push(start);
+    seen[start->getY() * SIZE + start->getX()] = 1;
+    int count = 0;
+
+    while (!queue.empty()) {
+        TilePtr t = queue.front();
+        queue.pop();
+        ++count;
+
+        for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+            TilePtr next = board.getTile(t, d);
+            if (next == nullptr || next->isCollision() ||
+                seen[next->getY() * SIZE + next->getX()])
+                continue;
+            GatePtr g = board.getGate(t, d);
+            if (g != nullptr && g->isActive())
+                continue;
+            seen[next->getY() * SIZE + next->getX()] = 1;
+            queue.push(next);
+        }
+    }
+
+    return count;
+}
+
+} // namespace
+
+int main() {
+    Board board = makeBoard();
+    BitBoard bits{board};
+
+    bench::Timer timer;
+    bench::keep(walk(board));
+    bench::report("Board walk", timer.ns() / STEPS, "ns/step");
+
+    timer = bench::Timer();
+    bench::keep(walk(bits));
+    bench::report("BitBoard walk", timer.ns() / STEPS, "ns/step");
+
+    // Colors are interned once, so the loops never take the registry lock.
+    ColorID ids[4];
+    for (int c = 0; c < 4; ++c)
+        ids[c] = ColorRegistry::intern(COLORS[c]);
+
+    timer = bench::Timer();
+    for (int i = 0; i < ROTATIONS; ++i)
+        board.rotateTiles(ids[i % 4], CLOCKWISE);
+    bench::report("Board rotateTiles", timer.ns() / ROTATIONS, "ns/op");
+
+    timer = bench::Timer();
+    for (int i = 0; i < ROTATIONS; ++i)
+        bits.rotateTiles(ids[i % 4], CLOCKWISE);
+    bench::report("BitBoard rotateTiles", timer.ns() / ROTATIONS, "ns/op");
+
+    timer = bench::Timer();
+    int cells = 0;
+    for (int i = 0; i < FILLS; ++i)
+        cells += floodFill(board);
+    bench::keep(cells);
+    bench::report("Board flood fill", timer.ns() / FILLS, "ns/op");
+
+    timer = bench::Timer();
+    int goals = 0;
+    for (int i = 0; i < FILLS; ++i)
+        goals += bits.reachable()[SIZE - 1] != 0;
+    bench::keep(goals);
+    bench::report("BitBoard flood fill", timer.ns() / FILLS, "ns/op");
+
+    return 0;
+}
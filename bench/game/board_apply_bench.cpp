@@ -0,0 +1,143 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Replays scripted sequences of 1M commands on a 256 x 256 pone::Board:
+// a mix of cursor moves, runs of rotations of one color and gate
+// toggles, and moves alone. Each script runs as one checkMove/
+// moveCursor, rotateTiles or toggleGate call per command with names,
+// and as one Board::apply call for the whole batch.
+
+#include "bench.hpp"
+#include "game/pone_board.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int SIZE = 256;
+constexpr int COLORS = 1024;
+constexpr int COMMANDS = 1000000;
+
+const std::string TYPES[] = {"empty", "up", "down", "left", "right"};
+
+Board makeBoard() {
+    std::mt19937 rng{7};
+    Board board{"bench", SIZE, SIZE};
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x)
+            board.add(std::make_shared<Tile>(
+                "t" + std::to_string(y * SIZE + x), y * SIZE + x + 1, x, y,
+                "c" + std::to_string(rng() % COLORS), TYPES[rng() % 5],
+                false));
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x + 1 < SIZE; x += 4)
+            board.add(std::make_shared<Gate>(
+                board.getTile(x, y), board.getTile(x + 1, y),
+                "g" + std::to_string(y * SIZE + x), "red", rng() % 2));
+
+    board.setCursorTile(board.getTile(SIZE / 2, SIZE / 2));
+    board.setJournalCapacity(1024);
+    return board;
+}
+
+/**
+ * A command as a script names it.
+ */
+struct Step {
+    CommandType type;
+    Direction d;
+    Rotation r;
+    std::string name; // Color or gate name
+};
+
+std::vector<Step> makeScript(const unsigned &movePercent) {
+    std::mt19937 rng{11};
+    std::vector<Step> script;
+    script.reserve(COMMANDS);
+
+    while (script.size() < COMMANDS) {
+        unsigned roll = rng() % 100;
+        if (roll < movePercent) {
+            script.push_back({CommandType::MOVE_CURSOR,
+                              static_cast<Direction>(rng() % 4), CLOCKWISE,
+                              ""});
+        } else if (roll < movePercent + (100 - movePercent) / 3) {
+            std::string color = "c" + std::to_string(rng() % COLORS);
+            for (unsigned k = 0, n = 1 + rng() % 4; k < n; ++k)
+                script.push_back({CommandType::ROTATE_TILES, UP,
+                                  static_cast<Rotation>(rng() % 2), color});
+        } else {
+            int x = rng() % (SIZE / 4) * 4, y = rng() % SIZE;
+            script.push_back({CommandType::TOGGLE_GATE, UP, CLOCKWISE,
+                              "g" + std::to_string(y * SIZE + x)});
+        }
+    }
+
+    script.resize(COMMANDS);
+    return script;
+}
+
+bool run(const std::string &name, const std::vector<Step> &script) {
+    Board board = makeBoard();
+    bench::Timer timer;
+    for (const Step &s : script) {
+        switch (s.type) {
+        case CommandType::MOVE_CURSOR:
+            if (board.checkMove(s.d))
+                board.moveCursor(s.d);
+            break;
+        case CommandType::ROTATE_TILES:
+            board.rotateTiles(s.name, s.r);
+            break;
+        case CommandType::TOGGLE_GATE:
+            board.toggleGate(board.getGate(s.name));
+            break;
+        }
+    }
+    std::uint64_t hash = board.stateHash();
+    bench::report(name + ", one call per command",
+                  COMMANDS / (timer.ns() / 1e3), "Mcommands/s");
+
+    // Lookups by name happen once, when the batch is built.
+    board = makeBoard();
+    timer = bench::Timer();
+    std::vector<Command> commands;
+    commands.reserve(COMMANDS);
+    for (const Step &s : script) {
+        switch (s.type) {
+        case CommandType::MOVE_CURSOR:
+            commands.push_back(Command::move(s.d));
+            break;
+        case CommandType::ROTATE_TILES:
+            commands.push_back(
+                Command::rotate(ColorRegistry::intern(s.name), s.r));
+            break;
+        case CommandType::TOGGLE_GATE:
+            commands.push_back(Command::toggle(board.getGateHandle(s.name)));
+            break;
+        }
+    }
+    bench::report(name + ", build batch", timer.ns() / 1e6, "ms");
+
+    timer = bench::Timer();
+    std::vector<CommandResult> results = board.apply(commands);
+    bench::report(name + ", apply", COMMANDS / (timer.ns() / 1e3),
+                  "Mcommands/s");
+    bench::keep(results);
+
+    return board.stateHash() == hash;
+}
+
+} // namespace
+
+int main() {
+    bool same = run("mixed", makeScript(85));
+    same &= run("moves", makeScript(100));
+    return same ? 0 : 1;
+}
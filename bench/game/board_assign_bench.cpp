@@ -0,0 +1,86 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Compares loading a 1000 x 1000 level (1M tiles, 250k gates) into a
+// pone::Board with one Board::assign call against one Board::add call
+// per tile and gate. Both start from the same Tile and Gate values.
+
+#include "bench.hpp"
+#include "game/pone_board.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int SIZE = 1000;
+
+const std::string COLORS[] = {"red", "green", "blue", "yellow"};
+const std::string TYPES[] = {"empty", "up", "down", "left", "right"};
+
+std::vector<Tile> makeTiles() {
+    std::mt19937 rng{7};
+    std::vector<Tile> tiles;
+    tiles.reserve(SIZE * SIZE);
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x)
+            tiles.emplace_back("t" + std::to_string(y * SIZE + x),
+                               y * SIZE + x + 1, x, y, COLORS[rng() % 4],
+                               TYPES[rng() % 5], false);
+
+    return tiles;
+}
+
+std::vector<Gate> makeGates(const std::vector<Tile> &tiles) {
+    std::vector<Gate> gates;
+    gates.reserve(SIZE * SIZE / 4);
+
+    for (int y = 0; y < SIZE; y += 2) {
+        for (int x = 0; x + 1 < SIZE; x += 2) {
+            int i = y * SIZE + x;
+            gates.emplace_back(std::make_shared<Tile>(tiles[i]),
+                               std::make_shared<Tile>(tiles[i + 1]),
+                               "g" + std::to_string(i), "red");
+        }
+    }
+
+    return gates;
+}
+
+} // namespace
+
+int main() {
+    std::vector<Tile> tiles = makeTiles();
+    std::vector<Gate> gates = makeGates(tiles);
+
+    std::size_t calls = bench::allocations();
+    bench::Timer timer;
+    {
+        Board board{"bench", SIZE, SIZE};
+        for (const Tile &t : tiles)
+            board.add(std::make_shared<Tile>(t));
+        for (const Gate &g : gates)
+            board.add(std::make_shared<Gate>(g));
+        bench::keep(board.stateHash());
+        bench::report("add", timer.ns() / 1e6, "ms");
+        bench::report("add allocations",
+                      static_cast<double>(bench::allocations() - calls), "");
+    }
+
+    calls = bench::allocations();
+    timer = bench::Timer();
+    {
+        Board board{"bench", SIZE, SIZE};
+        board.assign(std::move(tiles), std::move(gates));
+        bench::keep(board.stateHash());
+        bench::report("assign", timer.ns() / 1e6, "ms");
+        bench::report("assign allocations",
+                      static_cast<double>(bench::allocations() - calls), "");
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Keeps a consumer's copy of the tile types of a 512 x 512 pone::Board
+// up to date while every frame moves the cursor, toggles a gate and
+// rotates a few tiles: by rescanning the whole board each frame, and
+// by applying only what Board::drainChanges reports.
+
+#include "bench.hpp"
+#include "game/pone_board.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int SIZE = 512;
+constexpr int FRAMES = 2000;
+constexpr int RESCAN_FRAMES = 100;
+constexpr int GATE_STEP = 4;
+
+const std::string TYPES[] = {"empty", "up", "down", "left", "right"};
+
+Board makeBoard() {
+    std::mt19937 rng{7};
+    std::vector<Tile> tiles;
+    std::vector<Gate> gates;
+    tiles.reserve(SIZE * SIZE);
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x)
+            tiles.emplace_back("t" + std::to_string(y * SIZE + x),
+                               y * SIZE + x + 1, x, y, "red",
+                               TYPES[rng() % 5], false);
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x + 1 < SIZE; x += GATE_STEP)
+            gates.emplace_back(std::make_shared<Tile>(tiles[y * SIZE + x]),
+                               std::make_shared<Tile>(tiles[y * SIZE + x + 1]),
+                               "g" + std::to_string(y * SIZE + x), "red");
+
+    Board board{"bench", SIZE, SIZE};
+    board.assign(std::move(tiles), std::move(gates));
+    board.setCursorTile(board.getTile(SIZE / 2, SIZE / 2));
+    return board;
+}
+
+void playFrame(Board &board, std::mt19937 &rng) {
+    for (int k = 0; k < 8; ++k)
+        board.tryMoveCursor(static_cast<Direction>(rng() % 4));
+
+    int x = rng() % (SIZE / GATE_STEP) * GATE_STEP, y = rng() % SIZE;
+    board.toggleGate(board.getGate(board.getTile(x, y), RIGHT));
+
+    for (int k = 0; k < 4; ++k) {
+        TilePtr t = board.getTile(rng() % SIZE, rng() % SIZE);
+        if (t->isDirection())
+            board.rotateTile(t, CLOCKWISE);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::vector<TileType> types(SIZE * SIZE);
+    long updates = 0;
+
+    Board board = makeBoard();
+    std::mt19937 rng{11};
+    bench::Timer timer;
+    for (int f = 0; f < RESCAN_FRAMES; ++f) {
+        playFrame(board, rng);
+        board.forEachTileIn(0, 0, SIZE - 1, SIZE - 1, [&](const TilePtr &t) {
+            TileType &type = types[t->getY() * SIZE + t->getX()];
+            updates += type != t->getTileType();
+            type = t->getTileType();
+        });
+    }
+    bench::keep(updates);
+    bench::report("rescan", timer.ns() / RESCAN_FRAMES / 1e3, "us/frame");
+
+    board = makeBoard();
+    rng.seed(11);
+    board.drainChanges();
+    long drained = 0;
+    timer = bench::Timer();
+    for (int f = 0; f < FRAMES; ++f) {
+        playFrame(board, rng);
+        for (const BoardChangeRecord &r : board.drainChanges().records) {
+            if (!(r.changed & BoardChangeRecord::TILE))
+                continue;
+            types[r.y * SIZE + r.x] = board.getTile(r.x, r.y)->getTileType();
+            ++drained;
+        }
+    }
+    bench::keep(drained);
+    bench::report("drainChanges", timer.ns() / FRAMES / 1e3, "us/frame");
+
+    board = makeBoard();
+    rng.seed(11);
+    timer = bench::Timer();
+    for (int f = 0; f < FRAMES; ++f)
+        playFrame(board, rng);
+    bench::report("frame changes alone", timer.ns() / FRAMES / 1e3,
+                  "us/frame");
+
+    return 0;
+}
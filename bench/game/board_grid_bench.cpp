@@ -0,0 +1,149 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Compares the row-major grid in pone::Board against the previous
+// layout of two AVL trees and two hash maps per tile on a 1k x 1k board.
+
+#include "bench.hpp"
+#include "game/pone_board.hpp"
+#include "utils/avl.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int LENGTH = 1000;
+constexpr int WIDTH = 1000;
+constexpr int PROBES = 1000000;
+
+// The legacy coordinate hash collides heavily, so it gets fewer probes.
+constexpr int LEGACY_PROBES = 10000;
+
+/* The tile indices Board kept before the grid. */
+struct LegacyLayout {
+    AVL<TilePtr, compareTileByCoords> tileCoordPairsTree;
+    AVL<TilePtr, compareTileByName> tileNamesTree;
+    std::unordered_map<std::string, TilePtr> tileNamesMap;
+    std::unordered_map<CoordPair, TilePtr, CoordPairHasher, CoordPairEquals>
+        tileCoordPairsMap;
+    TilePairGateMap gateTilePairsMap;
+
+    void add(const TilePtr &t) {
+        tileNamesTree.insert(t);
+        tileNamesMap[t->getName()] = t;
+        tileCoordPairsTree.insert(t);
+        tileCoordPairsMap[t->getCoordPair()] = t;
+    }
+
+    TilePtr getTile(const int &x, const int &y) const {
+        auto it = tileCoordPairsMap.find(CoordPair{x, y});
+        return it == tileCoordPairsMap.end() ? nullptr : it->second;
+    }
+
+    bool checkMove(const TilePtr &curr, const int &dx, const int &dy) const {
+        TilePtr target = getTile(curr->getX() + dx, curr->getY() + dy);
+        if (target == nullptr || target->isCollision())
+            return false;
+        return !gateTilePairsMap.contains(TilePair{curr, target});
+    }
+};
+
+std::vector<TilePtr> makeTiles() {
+    std::vector<TilePtr> tiles;
+    tiles.reserve(LENGTH * WIDTH);
+    for (int y = 0; y < WIDTH; ++y)
+        for (int x = 0; x < LENGTH; ++x)
+            tiles.push_back(std::make_shared<Tile>(
+                "t" + std::to_string(y * LENGTH + x), y * LENGTH + x + 1, x,
+                y, "none", "empty", false));
+    return tiles;
+}
+
+std::vector<CoordPair> makeProbes() {
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> xs{0, LENGTH - 1}, ys{0, WIDTH - 1};
+    std::vector<CoordPair> probes(PROBES);
+    for (CoordPair &p : probes)
+        p = CoordPair{xs(rng), ys(rng)};
+    return probes;
+}
+
+} // namespace
+
+int main() {
+    std::vector<TilePtr> tiles = makeTiles();
+    std::vector<CoordPair> probes = makeProbes();
+    const double n = static_cast<double>(tiles.size());
+
+    {
+        std::size_t before = bench::liveBytes();
+        bench::Timer timer;
+        LegacyLayout legacy;
+        for (const TilePtr &t : tiles)
+            legacy.add(t);
+        bench::report("legacy build", timer.ns() / n, "ns/tile");
+        bench::report("legacy index memory",
+                      (bench::liveBytes() - before) / n, "bytes/tile");
+
+        timer = bench::Timer();
+        int hits = 0;
+        for (int i = 0; i < LEGACY_PROBES; ++i)
+            hits += legacy.getTile(probes[i].first, probes[i].second) !=
+                    nullptr;
+        bench::keep(hits);
+        bench::report("legacy getTile(x, y)", timer.ns() / LEGACY_PROBES,
+                      "ns/op");
+
+        timer = bench::Timer();
+        int moves = 0;
+        for (int i = 0; i < LEGACY_PROBES; ++i) {
+            const CoordPair &p = probes[i];
+            moves += legacy.checkMove(tiles[p.second * LENGTH + p.first], 0,
+                                      p.first % 2 ? 1 : -1);
+        }
+        bench::keep(moves);
+        bench::report("legacy checkMove", timer.ns() / LEGACY_PROBES,
+                      "ns/op");
+    }
+
+    {
+        std::size_t before = bench::liveBytes();
+        bench::Timer timer;
+        Board board{"bench", LENGTH, WIDTH};
+        for (const TilePtr &t : tiles)
+            board.add(t);
+        bench::report("grid build", timer.ns() / n, "ns/tile");
+        bench::report("grid index memory", (bench::liveBytes() - before) / n,
+                      "bytes/tile");
+
+        timer = bench::Timer();
+        int hits = 0;
+        for (const CoordPair &p : probes)
+            hits += board.getTile(p.first, p.second) != nullptr;
+        bench::keep(hits);
+        bench::report("grid getTile(x, y)", timer.ns() / PROBES, "ns/op");
+
+        timer = bench::Timer();
+        hits = 0;
+        for (const CoordPair &p : probes)
+            hits += board.getTile(tiles[p.second * LENGTH + p.first], UP) !=
+                    nullptr;
+        bench::keep(hits);
+        bench::report("grid getTile(t, UP)", timer.ns() / PROBES, "ns/op");
+
+        timer = bench::Timer();
+        int moves = 0;
+        for (const CoordPair &p : probes) {
+            board.setCursorTile(tiles[p.second * LENGTH + p.first]);
+            moves += board.checkMove(p.first % 2 ? UP : DOWN);
+        }
+        bench::keep(moves);
+        bench::report("grid checkMove", timer.ns() / PROBES, "ns/op");
+    }
+
+    return 0;
+}
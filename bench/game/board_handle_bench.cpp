@@ -0,0 +1,124 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Compares walking a 256 x 256 pone::Board through shared_ptr tiles
+// and gates (TilePtr/GatePtr) against 32-bit handles: the same
+// breadth-first flood fill from the cursor, through either API.
+
+#include "bench.hpp"
+#include "game/pone_board.hpp"
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int SIZE = 256;
+constexpr int FILLS = 20;
+
+const std::string TYPES[] = {"empty", "empty", "empty", "collision"};
+
+Board makeBoard() {
+    std::mt19937 rng{7};
+    Board board{"bench", SIZE, SIZE};
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x)
+            board.add(std::make_shared<Tile>(
+                "t" + std::to_string(y * SIZE + x), y * SIZE + x + 1, x, y,
+                "red", (x | y) ? TYPES[rng() % 4] : "empty", false));
+
+    for (int y = 0; y + 1 < SIZE; ++y)
+        for (int x = 0; x + 1 < SIZE; ++x)
+            if (rng() % 8 == 0)
+                board.add(std::make_shared<Gate>(
+                    board.getTile(x, y), board.getTile(x + 1, y),
+                    "g" + std::to_string(y * SIZE + x), "red", true));
+
+    board.setCursorTile(board.getTile(0, 0));
+    return board;
+}
+
+int fillByPointer(const Board &board) {
+    std::vector<char> seen(SIZE * SIZE, 0);
+    std::queue<TilePtr> queue;
+    queue.push(board.getCursorTile());
+    seen[0] = 1;
+    int count = 0;
+
+    while (!queue.empty()) {
+        TilePtr t = queue.front();
+        queue.pop();
+        ++count;
+
+        for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+            TilePtr next = board.getTile(t, d);
+            if (next == nullptr || next->isCollision() ||
+                seen[next->getY() * SIZE + next->getX()])
+                continue;
+            GatePtr g = board.getGate(t, d);
+            if (g != nullptr && g->isActive())
+                continue;
+            seen[next->getY() * SIZE + next->getX()] = 1;
+            queue.push(next);
+        }
+    }
+
+    return count;
+}
+
+int fillByHandle(const Board &board) {
+    std::vector<char> seen(SIZE * SIZE, 0);
+    std::queue<TileHandle> queue;
+    queue.push(board.getCursorHandle());
+    seen[0] = 1;
+    int count = 0;
+
+    while (!queue.empty()) {
+        TileHandle t = queue.front();
+        queue.pop();
+        ++count;
+
+        for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+            TileHandle next = board.getTileHandle(t, d);
+            TileType type;
+            if (!board.getTileType(next, type) ||
+                type == TileType::COLLISION || seen[next.index()])
+                continue;
+            const Gate *g = board.getGate(board.getGateHandle(t, d));
+            if (g != nullptr && g->isActive())
+                continue;
+            seen[next.index()] = 1;
+            queue.push(next);
+        }
+    }
+
+    return count;
+}
+
+} // namespace
+
+int main() {
+    Board board = makeBoard();
+
+    int cells = 0;
+    bench::Timer timer;
+    for (int i = 0; i < FILLS; ++i)
+        cells += fillByPointer(board);
+    bench::keep(cells);
+    bench::report("TilePtr flood fill", timer.ns() / FILLS / 1e6, "ms/op");
+
+    int handleCells = 0;
+    timer = bench::Timer();
+    for (int i = 0; i < FILLS; ++i)
+        handleCells += fillByHandle(board);
+    bench::keep(handleCells);
+    bench::report("TileHandle flood fill", timer.ns() / FILLS / 1e6,
+                  "ms/op");
+
+    return cells == handleCells ? 0 : 1;
+}
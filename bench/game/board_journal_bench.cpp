@@ -0,0 +1,93 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Measures the pone::Board undo journal: 1M recorded changes (cursor
+// moves and gate toggles, with a color group rotation every 1024th),
+// 1M undo/redo cycles over them, and the heap held by the journal.
+
+#include "bench.hpp"
+#include "game/pone_board.hpp"
+#include <random>
+#include <string>
+
+using namespace pone;
+
+namespace {
+
+constexpr int SIZE = 64;
+constexpr int CHANGES = 1000000;
+
+const std::string COLORS[] = {"red", "green", "blue", "yellow"};
+const std::string TYPES[] = {"empty", "up", "down", "left", "right"};
+
+Board makeBoard() {
+    std::mt19937 rng{7};
+    Board board{"bench", SIZE, SIZE};
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x)
+            board.add(std::make_shared<Tile>(
+                "t" + std::to_string(y * SIZE + x), y * SIZE + x + 1, x, y,
+                COLORS[rng() % 4], TYPES[rng() % 5], false));
+
+    for (int y = 0; y + 1 < SIZE; y += 2)
+        for (int x = 0; x + 1 < SIZE; x += 2)
+            board.add(std::make_shared<Gate>(
+                board.getTile(x, y), board.getTile(x + 1, y),
+                "g" + std::to_string(y * SIZE + x), "red"));
+
+    board.setCursorTile(board.getTile(0, 0));
+    return board;
+}
+
+} // namespace
+
+int main() {
+    Board board = makeBoard();
+    board.setJournalCapacity(CHANGES);
+    std::mt19937 rng{11};
+    ColorID ids[4];
+    for (int c = 0; c < 4; ++c)
+        ids[c] = ColorRegistry::intern(COLORS[c]);
+
+    std::size_t before = bench::liveBytes();
+    bench::Timer timer;
+    for (int i = 0; i < CHANGES; ++i) {
+        Direction d = static_cast<Direction>(rng() % 4);
+        if (i % 1024 == 0) {
+            board.rotateTiles(ids[rng() % 4], CLOCKWISE);
+        } else if (i % 2 == 0 && board.checkMove(d)) {
+            board.moveCursor(d);
+        } else {
+            int x = 2 * (rng() % (SIZE / 2)), y = 2 * (rng() % (SIZE / 2));
+            board.toggleGate(board.getGate(board.getTile(x, y), RIGHT));
+        }
+    }
+    bench::report("record", timer.ns() / CHANGES, "ns/change");
+    bench::report("journal heap",
+                  static_cast<double>(bench::liveBytes() - before) / CHANGES,
+                  "bytes/change");
+
+    std::uint64_t end = board.stateHash();
+
+    timer = bench::Timer();
+    while (board.undo())
+        ;
+    bench::report("undo", timer.ns() / CHANGES, "ns/op");
+
+    timer = bench::Timer();
+    while (board.redo())
+        ;
+    bench::report("redo", timer.ns() / CHANGES, "ns/op");
+
+    timer = bench::Timer();
+    for (int i = 0; i < CHANGES; ++i) {
+        board.undo();
+        board.redo();
+    }
+    bench::report("undo/redo cycle", timer.ns() / CHANGES, "ns/cycle");
+
+    bench::keep(board.stateHash() == end);
+    return board.stateHash() == end ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Gathers the four neighbours and edge gates of every tile on a
+// 256 x 256 pone::Board (one cell in eight empty, one in eight a
+// collision, one edge in eight gated): through getTile/getGate on
+// TilePtrs, through handles one direction at a time, and with one
+// getNeighbors call per tile.
+
+#include "bench.hpp"
+#include "game/pone_board.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int SIZE = 256;
+constexpr int ROUNDS = 20;
+
+const std::string TYPES[] = {"empty", "empty", "empty", "empty",
+                             "empty", "empty", "empty", "collision"};
+
+Board makeBoard() {
+    std::mt19937 rng{7};
+    Board board{"bench", SIZE, SIZE};
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x)
+            if (rng() % 8 != 0)
+                board.add(std::make_shared<Tile>(
+                    "t" + std::to_string(y * SIZE + x), y * SIZE + x + 1, x,
+                    y, "red", TYPES[rng() % 8], false));
+
+    for (int y = 0; y + 1 < SIZE; ++y) {
+        for (int x = 0; x + 1 < SIZE; ++x) {
+            TilePtr t1 = board.getTile(x, y), t2 = board.getTile(x, y + 1);
+            if (t1 != nullptr && t2 != nullptr && rng() % 8 == 0)
+                board.add(std::make_shared<Gate>(
+                    t1, t2, "g" + std::to_string(y * SIZE + x), "red", true));
+        }
+    }
+
+    return board;
+}
+
+} // namespace
+
+int main() {
+    Board board = makeBoard();
+    std::vector<TilePtr> tiles;
+    std::vector<TileHandle> handles;
+    for (int y = 0; y < SIZE; ++y) {
+        for (int x = 0; x < SIZE; ++x) {
+            if (TilePtr t = board.getTile(x, y)) {
+                tiles.push_back(t);
+                handles.push_back(board.getTileHandle(x, y));
+            }
+        }
+    }
+    const double visits = static_cast<double>(ROUNDS) * tiles.size();
+
+    long found = 0;
+    bench::Timer timer;
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (const TilePtr &t : tiles) {
+            for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+                found += board.getTile(t, d) != nullptr;
+                found += board.getGate(t, d) != nullptr;
+            }
+        }
+    }
+    bench::keep(found);
+    bench::report("TilePtr getTile + getGate", timer.ns() / visits,
+                  "ns/tile");
+
+    long handleFound = 0;
+    timer = bench::Timer();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (const TileHandle &h : handles) {
+            for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+                handleFound += !board.getTileHandle(h, d).isNull();
+                handleFound += !board.getGateHandle(h, d).isNull();
+            }
+        }
+    }
+    bench::keep(handleFound);
+    bench::report("handle per direction", timer.ns() / visits, "ns/tile");
+
+    long batchFound = 0;
+    timer = bench::Timer();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (const TileHandle &h : handles) {
+            TileNeighbors n;
+            board.getNeighbors(h, n);
+            for (Direction d : {UP, DOWN, LEFT, RIGHT})
+                batchFound += !n.tiles[d].isNull() + !n.gates[d].isNull();
+        }
+    }
+    bench::keep(batchFound);
+    bench::report("getNeighbors", timer.ns() / visits, "ns/tile");
+
+    return found == handleFound && found == batchFound ? 0 : 1;
+}
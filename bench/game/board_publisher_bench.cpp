@@ -0,0 +1,133 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Measures read-mostly sharing of a 256 x 256 pone::Board: the cost of
+// a query (getTile, checkMove, cursorOnGoal) through a BoardReader,
+// through BoardPublisher::read and under a mutex, the cost of a
+// publish, and query throughput of 1, 2 and 4 reader threads while a
+// writer moves the cursor and publishes.
+
+#include "bench.hpp"
+#include "game/pone_publisher.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int SIZE = 256;
+constexpr int QUERIES = 2000000;
+constexpr int PUBLISHES = 200000;
+constexpr auto RUN_TIME = std::chrono::milliseconds{300};
+
+const std::string TYPES[] = {"empty", "up", "down", "left", "right"};
+
+Board makeBoard() {
+    std::mt19937 rng{7};
+    std::vector<Tile> tiles;
+    tiles.reserve(SIZE * SIZE);
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x)
+            tiles.emplace_back("t" + std::to_string(y * SIZE + x),
+                               y * SIZE + x + 1, x, y, "red",
+                               TYPES[rng() % 5], false);
+
+    Board board{"bench", SIZE, SIZE};
+    board.assign(std::move(tiles), {});
+    board.setCursorTile(board.getTile(SIZE / 2, SIZE / 2));
+    return board;
+}
+
+int query(const Board &board, const int &k) {
+    return (board.getTile(k % SIZE, (k / SIZE) % SIZE) != nullptr) +
+           board.checkMove(static_cast<Direction>(k % 4)) +
+           board.cursorOnGoal();
+}
+
+} // namespace
+
+int main() {
+    Board board = makeBoard();
+    BoardPublisher publisher{board};
+
+    long found = 0;
+    bench::Timer timer;
+    for (int k = 0; k < QUERIES; ++k)
+        found += query(board, k);
+    bench::keep(found);
+    bench::report("query, unshared", timer.ns() / QUERIES, "ns/op");
+
+    BoardReader reader{publisher};
+    timer = bench::Timer();
+    for (int k = 0; k < QUERIES; ++k)
+        found += query(reader.current(), k);
+    bench::keep(found);
+    bench::report("query via BoardReader", timer.ns() / QUERIES, "ns/op");
+
+    timer = bench::Timer();
+    for (int k = 0; k < QUERIES; ++k)
+        found += query(*publisher.read(), k);
+    bench::keep(found);
+    bench::report("query via read()", timer.ns() / QUERIES, "ns/op");
+
+    std::mutex mutex;
+    timer = bench::Timer();
+    for (int k = 0; k < QUERIES; ++k) {
+        std::lock_guard<std::mutex> lock{mutex};
+        found += query(board, k);
+    }
+    bench::keep(found);
+    bench::report("query under a mutex", timer.ns() / QUERIES, "ns/op");
+
+    timer = bench::Timer();
+    for (int k = 0; k < PUBLISHES; ++k) {
+        board.tryMoveCursor(static_cast<Direction>(k % 4));
+        publisher.publish(board);
+    }
+    bench::report("move + publish", timer.ns() / PUBLISHES, "ns/op");
+
+    for (int readers : {1, 2, 4}) {
+        std::atomic<bool> done{false};
+        std::atomic<long> queries{0};
+        std::vector<std::thread> threads;
+
+        for (int r = 0; r < readers; ++r) {
+            threads.emplace_back([&] {
+                BoardReader reader{publisher};
+                long count = 0, sum = 0;
+                while (!done.load(std::memory_order_relaxed))
+                    sum += query(reader.current(), count++);
+                bench::keep(sum);
+                queries += count;
+            });
+        }
+
+        std::mt19937 rng{11};
+        auto end = std::chrono::steady_clock::now() + RUN_TIME;
+        while (std::chrono::steady_clock::now() < end) {
+            board.tryMoveCursor(static_cast<Direction>(rng() % 4));
+            publisher.publish(board);
+            std::this_thread::yield();
+        }
+        done = true;
+        for (std::thread &t : threads)
+            t.join();
+
+        double seconds = std::chrono::duration<double>(RUN_TIME).count();
+        bench::report(std::to_string(readers) + " readers + writer",
+                      queries.load() / seconds / 1e6, "Mqueries/s");
+    }
+
+    bench::report("hardware threads",
+                  static_cast<double>(std::thread::hardware_concurrency()),
+                  "");
+    return 0;
+}
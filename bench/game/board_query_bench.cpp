@@ -0,0 +1,132 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Measures routine misses on a 256 x 256 pone::Board with holes:
+// a random walk that keeps running into edges and holes, moved with
+// a throwing moveCursor, checkMove + moveCursor, and tryMoveCursor;
+// and neighbour and gate probes along the board border.
+
+#include "bench.hpp"
+#include "game/pone_board.hpp"
+#include "game/pone_except.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int SIZE = 256;
+constexpr int STEPS = 1000000;
+
+Board makeBoard() {
+    std::mt19937 rng{7};
+    Board board{"bench", SIZE, SIZE};
+
+    // One cell in eight is a hole, so a walk misses often.
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x)
+            if (!(x | y) || rng() % 8 != 0)
+                board.add(std::make_shared<Tile>(
+                    "t" + std::to_string(y * SIZE + x), y * SIZE + x + 1, x,
+                    y, "red", "empty", false));
+
+    board.setCursorTile(board.getTile(0, 0));
+    board.setJournalCapacity(0);
+    return board;
+}
+
+std::vector<Direction> makeWalk() {
+    std::mt19937 rng{11};
+    std::vector<Direction> walk(STEPS);
+    for (Direction &d : walk)
+        d = static_cast<Direction>(rng() % 4);
+    return walk;
+}
+
+} // namespace
+
+int main() {
+    std::vector<Direction> walk = makeWalk();
+
+    Board board = makeBoard();
+    int moved = 0;
+    bench::Timer timer;
+    for (Direction d : walk) {
+        try {
+            board.moveCursor(d);
+            ++moved;
+        } catch (const InvalidTileException &) {
+        }
+    }
+    bench::keep(moved);
+    bench::report("moveCursor + catch", timer.ns() / STEPS, "ns/step");
+    bench::report("misses", 100.0 * (STEPS - moved) / STEPS, "%");
+
+    board = makeBoard();
+    moved = 0;
+    timer = bench::Timer();
+    for (Direction d : walk) {
+        if (board.checkMove(d)) {
+            board.moveCursor(d);
+            ++moved;
+        }
+    }
+    bench::keep(moved);
+    bench::report("checkMove + moveCursor", timer.ns() / STEPS, "ns/step");
+
+    board = makeBoard();
+    moved = 0;
+    timer = bench::Timer();
+    for (Direction d : walk)
+        moved += board.tryMoveCursor(d);
+    bench::keep(moved);
+    bench::report("tryMoveCursor", timer.ns() / STEPS, "ns/step");
+
+    // Every tile on the border has at least one neighbour and one
+    // gate slot off the board.
+    std::vector<TilePtr> border;
+    std::vector<TileHandle> borderHandles;
+    for (int k = 0; k < SIZE; ++k) {
+        for (TilePtr t : {board.getTile(k, 0), board.getTile(0, k)}) {
+            if (t == nullptr)
+                continue;
+            border.push_back(t);
+            borderHandles.push_back(board.getTileHandle(t->getName()));
+        }
+    }
+
+    const int probes = STEPS / static_cast<int>(border.size()) + 1;
+    int found = 0;
+    timer = bench::Timer();
+    for (int p = 0; p < probes; ++p) {
+        for (const TilePtr &t : border) {
+            for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+                found += board.getTile(t, d) != nullptr;
+                found += board.getGate(t, d) != nullptr;
+            }
+        }
+    }
+    bench::keep(found);
+    bench::report("TilePtr border probe",
+                  timer.ns() / (probes * border.size() * 4), "ns/probe");
+
+    found = 0;
+    timer = bench::Timer();
+    for (int p = 0; p < probes; ++p) {
+        for (const TileHandle &t : borderHandles) {
+            for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+                found += !board.getTileHandle(t, d).isNull();
+                found += !board.getGateHandle(t, d).isNull();
+            }
+        }
+    }
+    bench::keep(found);
+    bench::report("TileHandle border probe",
+                  timer.ns() / (probes * borderHandles.size() * 4),
+                  "ns/probe");
+
+    return 0;
+}
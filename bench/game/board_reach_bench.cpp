@@ -0,0 +1,138 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Answers "can the cursor reach the goal?" on a 256 x 256 pone::Board
+// (one tile in five a collision tile, one edge in eight gated) after
+// every gate toggle: with a breadth-first flood fill per query, and
+// with Board::reachable, both when toggles only open gates (index
+// updated in place) and when they close them (index rebuilt).
+
+#include "bench.hpp"
+#include "game/pone_board.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int SIZE = 256;
+constexpr int FLOOD_QUERIES = 50;
+constexpr int QUERIES = 20000;
+
+const std::string TYPES[] = {"empty", "empty", "empty", "empty",
+                             "collision"};
+
+Board makeBoard(std::vector<GatePtr> &gates) {
+    std::mt19937 rng{7};
+    Board board{"bench", SIZE, SIZE};
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x)
+            board.add(std::make_shared<Tile>(
+                "t" + std::to_string(y * SIZE + x), y * SIZE + x + 1, x, y,
+                "red", (x | y) && x + y != 2 * SIZE - 2 ? TYPES[rng() % 5]
+                                                        : "empty",
+                false));
+
+    for (int y = 0; y + 1 < SIZE; ++y) {
+        for (int x = 0; x + 1 < SIZE; ++x) {
+            if (rng() % 8)
+                continue;
+            TilePtr t = board.getTile(x, y);
+            TilePtr n = board.getTile(x + (y % 2), y + 1 - (y % 2));
+            gates.push_back(std::make_shared<Gate>(
+                t, n, "g" + std::to_string(y * SIZE + x), "red", true));
+            board.add(gates.back());
+        }
+    }
+
+    board.setCursorTile(board.getTile(0, 0));
+    return board;
+}
+
+bool flood(const Board &board, const TileHandle &from,
+           const TileHandle &to) {
+    std::vector<char> seen(SIZE * SIZE, 0);
+    std::vector<TileHandle> stack{from};
+    seen[from.index() % seen.size()] = 1;
+
+    while (!stack.empty()) {
+        TileHandle h = stack.back();
+        stack.pop_back();
+        if (h == to)
+            return true;
+
+        TileNeighbors n;
+        board.getNeighbors(h, n);
+        for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+            if (!(n.open & (1 << d)))
+                continue;
+            const Tile *t = board.getTile(n.tiles[d]);
+            char &mark = seen[t->getY() * SIZE + t->getX()];
+            if (!mark) {
+                mark = 1;
+                stack.push_back(n.tiles[d]);
+            }
+        }
+    }
+
+    return false;
+}
+
+} // namespace
+
+int main() {
+    std::vector<GatePtr> gates;
+    Board board = makeBoard(gates);
+    TileHandle cursor = board.getCursorHandle();
+    TileHandle goal = board.getTileHandle(SIZE - 1, SIZE - 1);
+    std::mt19937 rng{11};
+
+    int found = 0;
+    bench::Timer timer;
+    for (int k = 0; k < FLOOD_QUERIES; ++k) {
+        board.toggleGate(board.getGate(gates[rng() % gates.size()]->getName()));
+        found += flood(board, cursor, goal);
+    }
+    bench::keep(found);
+    bench::report("toggle + flood fill", timer.ns() / FLOOD_QUERIES / 1e3,
+                  "us/query");
+
+    timer = bench::Timer();
+    for (int k = 0; k < FLOOD_QUERIES; ++k) {
+        board.toggleGate(board.getGate(gates[rng() % gates.size()]->getName()));
+        found += board.reachable(cursor, goal);
+    }
+    bench::keep(found);
+    bench::report("toggle + reachable", timer.ns() / FLOOD_QUERIES / 1e3,
+                  "us/query");
+
+    for (const GatePtr &g : gates)
+        board.setGateActive(board.getGate(g->getName()), true);
+    board.reachable(cursor, goal);
+
+    timer = bench::Timer();
+    int opened = 0;
+    for (int k = 0; k < QUERIES && opened < static_cast<int>(gates.size());
+         ++k, ++opened) {
+        board.setGateActive(board.getGate(gates[opened]->getName()), false);
+        found += board.reachable(cursor, goal);
+    }
+    bench::keep(found);
+    bench::report("open gate + reachable", timer.ns() / opened / 1e3,
+                  "us/query");
+
+    timer = bench::Timer();
+    for (int k = 0; k < FLOOD_QUERIES; ++k) {
+        board.setGateActive(board.getGate(gates[k]->getName()), true);
+        found += board.reachable(cursor, goal);
+    }
+    bench::keep(found);
+    bench::report("close gate + reachable (rebuild)",
+                  timer.ns() / FLOOD_QUERIES / 1e3, "us/query");
+
+    return 0;
+}
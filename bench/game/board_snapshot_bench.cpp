@@ -0,0 +1,90 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Measures pone::Board snapshots on a 256 x 256 puzzle: the cost of
+// taking a snapshot, and the heap held by thousands of live branches
+// that each diverge by a few moves, rotations and gate toggles.
+
+#include "bench.hpp"
+#include "game/pone_board.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int SIZE = 256;
+constexpr int SNAPSHOTS = 1000000;
+constexpr int BRANCHES = 2000;
+constexpr int CHANGES = 8;
+
+const std::string TYPES[] = {"empty", "up", "down", "left", "right"};
+
+Board makeBoard() {
+    std::mt19937 rng{7};
+    Board board{"bench", SIZE, SIZE};
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x)
+            board.add(std::make_shared<Tile>(
+                "t" + std::to_string(y * SIZE + x), y * SIZE + x + 1, x, y,
+                "red", TYPES[rng() % 5], false));
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x + 1 < SIZE; x += 2)
+            board.add(std::make_shared<Gate>(
+                board.getTile(x, y), board.getTile(x + 1, y),
+                "g" + std::to_string(y * SIZE + x), "red"));
+
+    board.setCursorTile(board.getTile(SIZE / 2, SIZE / 2));
+    return board;
+}
+
+} // namespace
+
+int main() {
+    std::size_t empty = bench::liveBytes();
+    Board board = makeBoard();
+    std::size_t full = bench::liveBytes() - empty;
+    bench::report("board heap", static_cast<double>(full), "bytes");
+
+    bench::Timer timer;
+    for (int i = 0; i < SNAPSHOTS; ++i) {
+        Board branch = board.snapshot();
+        bench::keep(branch);
+    }
+    bench::report("snapshot", timer.ns() / SNAPSHOTS, "ns/op");
+
+    std::mt19937 rng{11};
+    std::vector<Board> branches;
+    branches.reserve(BRANCHES);
+    std::size_t before = bench::liveBytes();
+
+    timer = bench::Timer();
+    for (int i = 0; i < BRANCHES; ++i) {
+        Board &branch = branches.emplace_back(board.snapshot());
+        for (int j = 0; j < CHANGES; ++j) {
+            int x = rng() % SIZE, y = rng() % SIZE;
+            TilePtr t = branch.getTile(x, y);
+            Direction d = static_cast<Direction>(rng() % 4);
+            if (t->isDirection())
+                branch.rotateTile(t, CLOCKWISE);
+            else if (branch.checkMove(d))
+                branch.moveCursor(d);
+            else
+                branch.toggleGate(branch.getGate(
+                    branch.getTile(x & ~1, y), RIGHT));
+        }
+    }
+    bench::report("branch and diverge", timer.ns() / BRANCHES, "ns/branch");
+
+    double perBranch =
+        static_cast<double>(bench::liveBytes() - before) / BRANCHES;
+    bench::report("branch heap", perBranch, "bytes/branch");
+    bench::report("branch heap / board heap", perBranch / full, "");
+
+    return 0;
+}
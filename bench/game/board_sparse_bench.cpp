@@ -0,0 +1,62 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Measures a mostly empty 4096 x 4096 pone::Board editor canvas: the
+// heap and time to create it, and the heap after authoring sixteen
+// 64 x 64 islands of tiles, against what a fully allocated grid of
+// the same chunks would hold.
+
+#include "bench.hpp"
+#include "game/pone_board.hpp"
+#include <string>
+
+using namespace pone;
+
+namespace {
+
+constexpr int SIZE = 4096;
+constexpr int ISLANDS = 16;
+constexpr int ISLAND = 64;
+
+} // namespace
+
+int main() {
+    std::size_t before = bench::liveBytes();
+    bench::Timer timer;
+    Board board{"canvas", SIZE, SIZE};
+    bench::report("create", timer.ns() / 1e6, "ms");
+    bench::report("empty canvas heap",
+                  static_cast<double>(bench::liveBytes() - before), "bytes");
+
+    int tiles = 0;
+    timer = bench::Timer();
+    for (int k = 0; k < ISLANDS; ++k) {
+        int x0 = (k % 4) * (SIZE / 4) + 100, y0 = (k / 4) * (SIZE / 4) + 37;
+        for (int y = y0; y < y0 + ISLAND; ++y) {
+            for (int x = x0; x < x0 + ISLAND; ++x) {
+                board.add(std::make_shared<Tile>(
+                    "t" + std::to_string(tiles), tiles + 1, x, y, "red",
+                    "empty", false));
+                ++tiles;
+            }
+        }
+    }
+    bench::report("author", timer.ns() / tiles, "ns/tile");
+
+    std::size_t used = bench::liveBytes() - before;
+    double dense = static_cast<double>(SIZE / BoardChunk::SIDE) *
+                   (SIZE / BoardChunk::SIDE) * sizeof(BoardChunk);
+    bench::report("authored tiles", tiles, "");
+    bench::report("allocated chunks", board.allocatedChunks(), "");
+    bench::report("canvas heap", static_cast<double>(used), "bytes");
+    bench::report("canvas heap per tile", static_cast<double>(used) / tiles,
+                  "bytes");
+    bench::report("dense chunk grid", dense, "bytes");
+
+    int dirty = 0;
+    board.forEachDirtyChunk([&](int, int, int, int) { ++dirty; });
+    bench::keep(dirty);
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Scrolls an 80 x 45 viewport across a 4096 x 4096 pone::Board (one
+// cell in four holds a tile, one tile in eight a gate) and collects
+// the visible tiles and gates each frame: with forEachTileIn and
+// forEachGateIn, with one point lookup per visible cell, and with a
+// scan of the whole board.
+
+#include "bench.hpp"
+#include "game/pone_board.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int SIZE = 4096;
+constexpr int VIEW_W = 80, VIEW_H = 45;
+constexpr int FRAMES = 4000;
+constexpr int FULL_FRAMES = 3;
+
+Board makeBoard() {
+    std::mt19937 rng{7};
+    std::vector<Tile> tiles;
+    std::vector<Gate> gates;
+    tiles.reserve(SIZE * SIZE / 4);
+
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x)
+            if (rng() % 4 == 0)
+                tiles.emplace_back("t" + std::to_string(y * SIZE + x),
+                                   y * SIZE + x + 1, x, y, "red", "empty",
+                                   false);
+
+    for (std::size_t k = 0; k + 1 < tiles.size(); ++k) {
+        const Tile &a = tiles[k], &b = tiles[k + 1];
+        if (b.getY() == a.getY() && b.getX() == a.getX() + 1 &&
+            rng() % 2 == 0)
+            gates.emplace_back(std::make_shared<Tile>(a),
+                               std::make_shared<Tile>(b),
+                               "g" + std::to_string(k), "red");
+    }
+
+    Board board{"bench", SIZE, SIZE};
+    board.assign(std::move(tiles), std::move(gates));
+    return board;
+}
+
+} // namespace
+
+int main() {
+    Board board = makeBoard();
+    long seen = 0;
+
+    bench::Timer timer;
+    for (int f = 0; f < FRAMES; ++f) {
+        int x0 = f, y0 = f / 2;
+        board.forEachTileIn(x0, y0, x0 + VIEW_W - 1, y0 + VIEW_H - 1,
+                            [&](const TilePtr &t) { seen += t->getX(); });
+        board.forEachGateIn(x0, y0, x0 + VIEW_W - 1, y0 + VIEW_H - 1,
+                            [&](const GatePtr &) { ++seen; });
+    }
+    bench::keep(seen);
+    bench::report("forEachTileIn + forEachGateIn", timer.ns() / FRAMES / 1e3,
+                  "us/frame");
+
+    long pointSeen = 0;
+    timer = bench::Timer();
+    for (int f = 0; f < FRAMES; ++f) {
+        int x0 = f, y0 = f / 2;
+        for (int y = y0; y < y0 + VIEW_H; ++y) {
+            for (int x = x0; x < x0 + VIEW_W; ++x) {
+                TilePtr t = board.getTile(x, y);
+                if (t == nullptr)
+                    continue;
+                pointSeen += t->getX();
+                for (Direction d : {LEFT, DOWN, RIGHT, UP}) {
+                    // Count gates into the viewport from outside once.
+                    TilePtr n = board.getTile(t, d);
+                    bool inside = n != nullptr && n->getX() >= x0 &&
+                                  n->getX() < x0 + VIEW_W &&
+                                  n->getY() >= y0 && n->getY() < y0 + VIEW_H;
+                    if ((d == RIGHT || d == UP || !inside) &&
+                        board.getGate(t, d) != nullptr)
+                        ++pointSeen;
+                }
+            }
+        }
+    }
+    bench::keep(pointSeen);
+    bench::report("point lookups", timer.ns() / FRAMES / 1e3, "us/frame");
+
+    long fullSeen = 0;
+    timer = bench::Timer();
+    for (int f = 0; f < FULL_FRAMES; ++f) {
+        int x0 = f, y0 = f / 2;
+        board.forEachTileIn(0, 0, SIZE - 1, SIZE - 1, [&](const TilePtr &t) {
+            if (t->getX() >= x0 && t->getX() < x0 + VIEW_W &&
+                t->getY() >= y0 && t->getY() < y0 + VIEW_H)
+                ++fullSeen;
+        });
+    }
+    bench::keep(fullSeen);
+    bench::report("whole-board scan", timer.ns() / FULL_FRAMES / 1e3,
+                  "us/frame");
+
+    return seen == pointSeen ? 0 : 1;
+}
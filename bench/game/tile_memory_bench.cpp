@@ -0,0 +1,93 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Builds a 1M-tile board and compares the footprint of pone::Tile
+// against the previous Tile, which stored its color and type as
+// strings next to a per-instance vector of every type name.
+
+#include "bench.hpp"
+#include "game/pone_board.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int LENGTH = 1000;
+constexpr int WIDTH = 1000;
+
+/* The data members of Tile before the type catalog was shared. */
+struct LegacyTile {
+    std::string m_name;
+    int m_id;
+    int m_x, m_y;
+    std::string m_color;
+    std::string m_type;
+    bool m_cursor;
+
+    const std::vector<std::string> types = {
+        "empty", "gswitch", "tswitch", "key",  "up",
+        "down",  "left",    "right",   "goal", "collision"};
+
+    LegacyTile(const std::string &name, const int &id, const int &x,
+               const int &y, const std::string &color,
+               const std::string &type, bool cursor)
+        : m_name{name}, m_id{id}, m_x{x}, m_y{y}, m_color{color},
+          m_type{type}, m_cursor{cursor} {}
+};
+
+/**
+ * Measures building LENGTH * WIDTH tiles of type T.
+ *
+ * @param label the prefix of the report lines.
+ */
+template <typename T> void buildTiles(const std::string &label) {
+    const double n = static_cast<double>(LENGTH) * WIDTH;
+    std::size_t bytes = bench::liveBytes();
+    std::size_t allocs = bench::allocations();
+    bench::Timer timer;
+
+    std::vector<std::shared_ptr<T>> tiles;
+    tiles.reserve(LENGTH * WIDTH);
+    for (int y = 0; y < WIDTH; ++y)
+        for (int x = 0; x < LENGTH; ++x)
+            tiles.push_back(std::make_shared<T>("t" + std::to_string(x),
+                                                y * LENGTH + x + 1, x, y,
+                                                "none", "empty", false));
+
+    bench::report(label + " build", timer.ns() / n, "ns/tile");
+    bench::report(label + " memory", (bench::liveBytes() - bytes) / n,
+                  "bytes/tile");
+    bench::report(label + " allocations",
+                  (bench::allocations() - allocs) / n, "allocs/tile");
+}
+
+} // namespace
+
+int main() {
+    bench::report("sizeof(legacy Tile)", sizeof(LegacyTile), "bytes");
+    bench::report("sizeof(Tile)", sizeof(Tile), "bytes");
+
+    buildTiles<LegacyTile>("legacy tiles");
+    buildTiles<Tile>("tiles");
+
+    const double n = static_cast<double>(LENGTH) * WIDTH;
+    std::size_t bytes = bench::liveBytes();
+    bench::Timer timer;
+
+    Board board{"bench", LENGTH, WIDTH};
+    for (int y = 0; y < WIDTH; ++y)
+        for (int x = 0; x < LENGTH; ++x)
+            board.add(std::make_shared<Tile>(
+                "t" + std::to_string(y * LENGTH + x), y * LENGTH + x + 1, x,
+                y, "none", "empty", false));
+
+    bench::report("1M-tile board build", timer.ns() / n, "ns/tile");
+    bench::report("1M-tile board memory", (bench::liveBytes() - bytes) / n,
+                  "bytes/tile");
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Traverses a pone::AVL of 1M ints in order: by copying it into a
+// vector with inorder(), with begin/end iterators, with rbegin/rend
+// and with forEach, then stops forEach after the first 1000 values.
+// Reports time and heap allocations per traversal. Then lists pages
+// of 50 values at random offsets, slicing inorder() and with select,
+// and counts values in random ranges with countInRange.
+
+#include "bench.hpp"
+#include "utils/avl.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int COUNT = 1000000;
+constexpr int ROUNDS = 10;
+constexpr int PAGE = 50;
+constexpr int QUERIES = 100000;
+
+template <typename Traverse>
+void run(const std::string &name, const Traverse &traverse) {
+    std::size_t calls = bench::allocations();
+    std::int64_t sum = 0;
+    bench::Timer timer;
+    for (int k = 0; k < ROUNDS; ++k)
+        sum += traverse();
+    double ns = timer.ns();
+    bench::keep(sum);
+    bench::report(name, ns / ROUNDS / 1e6, "ms");
+    bench::report(name + ", allocations",
+                  static_cast<double>(bench::allocations() - calls) / ROUNDS,
+                  "");
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng{7};
+    AVL<int> tree;
+    for (int i = 0; i < COUNT; ++i)
+        tree.insert(static_cast<int>(rng()));
+
+    run("inorder() vector", [&] {
+        std::int64_t sum = 0;
+        for (int x : tree.inorder())
+            sum += x;
+        return sum;
+    });
+
+    run("iterators", [&] {
+        std::int64_t sum = 0;
+        for (int x : tree)
+            sum += x;
+        return sum;
+    });
+
+    run("reverse iterators", [&] {
+        std::int64_t sum = 0;
+        for (auto it = tree.rbegin(); it != tree.rend(); ++it)
+            sum += *it;
+        return sum;
+    });
+
+    run("forEach", [&] {
+        std::int64_t sum = 0;
+        tree.forEach([&](const int &x) { sum += x; });
+        return sum;
+    });
+
+    run("forEach, first 1000", [&] {
+        std::int64_t sum = 0;
+        int left = 1000;
+        tree.forEach([&](const int &x) {
+            sum += x;
+            return --left > 0;
+        });
+        return sum;
+    });
+
+    run("page via inorder()", [&] {
+        std::vector<int> all = tree.inorder();
+        std::int64_t sum = 0;
+        for (int j = 0, k = rng() % (COUNT - PAGE); j < PAGE; ++j)
+            sum += all[k + j];
+        return sum;
+    });
+
+    std::int64_t sum = 0;
+    bench::Timer timer;
+    for (int q = 0; q < QUERIES; ++q) {
+        auto it = tree.select(rng() % (COUNT - PAGE));
+        for (int j = 0; j < PAGE; ++j)
+            sum += *it++;
+    }
+    bench::keep(sum);
+    bench::report("page via select", timer.ns() / QUERIES / 1e3, "us");
+
+    timer = bench::Timer();
+    for (int q = 0; q < QUERIES; ++q) {
+        int lo = static_cast<int>(rng());
+        sum += tree.countInRange(lo, lo + (1 << 20));
+    }
+    bench::keep(sum);
+    bench::report("countInRange", timer.ns() / QUERIES / 1e3, "us");
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Inserts 1M and 10M sequential and random ints into an AVL subtree
+// with the iterative AVLNode::insert and with a recursive insert that
+// rebalances every node on the way back up, as AVLNode::insert used
+// to. Both take nodes from an AVLNodePool. Then times AVLNode::find
+// and AVLNode::remove of every key.
+
+#include "bench.hpp"
+#include "utils/avl.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+using Node = AVLNode<int>;
+using Pool = AVLNodePool<Node>;
+
+Node *recursiveInsert(Node *root, const int &key, Pool &pool) {
+    if (root == nullptr)
+        return Node::create(pool, key);
+
+    if (key < root->data)
+        root->left = recursiveInsert(root->left, key, pool);
+    else
+        root->right = recursiveInsert(root->right, key, pool);
+
+    Node::setHeight(root);
+    return Node::rebalance(root);
+}
+
+void run(const std::string &name, const std::vector<int> &keys) {
+    double count = static_cast<double>(keys.size());
+    {
+        Pool pool;
+        Node *root = nullptr;
+        bench::Timer timer;
+        for (int key : keys)
+            root = recursiveInsert(root, key, pool);
+        bench::report(name + ", recursive insert", timer.ns() / count,
+                      "ns/op");
+        Node::destroyAll(root, pool);
+    }
+
+    Pool pool;
+    Node *root = nullptr;
+    bench::Timer timer;
+    for (int key : keys)
+        root = Node::insert(root, key, pool);
+    bench::report(name + ", iterative insert", timer.ns() / count, "ns/op");
+
+    long found = 0;
+    timer = bench::Timer();
+    for (int key : keys)
+        found += Node::find(root, key) != nullptr;
+    bench::keep(found);
+    bench::report(name + ", find", timer.ns() / count, "ns/op");
+
+    timer = bench::Timer();
+    for (int key : keys)
+        root = Node::remove(root, key, pool);
+    bench::report(name + ", remove", timer.ns() / count, "ns/op");
+}
+
+} // namespace
+
+int main() {
+    for (int count : {1000000, 10000000}) {
+        std::string size = count == 1000000 ? "1M" : "10M";
+        std::vector<int> keys(count);
+        for (int i = 0; i < count; ++i)
+            keys[i] = i;
+        run(size + " sequential", keys);
+
+        std::mt19937 rng{7};
+        for (int &key : keys)
+            key = static_cast<int>(rng());
+        run(size + " random", keys);
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Compares the AVL node allocation policies, AVLHeapAllocator (one new
+// per node) and AVLNodePool (slabs and a free list): building a tree
+// of 1M random ints, then 2M mixed operations that insert a new key or
+// remove a present one with equal odds, then an in-order traversal of
+// the churned tree. Reports time and heap allocations of each phase.
+
+#include "bench.hpp"
+#include "utils/avl.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int COUNT = 1000000;
+constexpr int OPERATIONS = 2000000;
+
+template <typename Tree> void run(const std::string &name) {
+    std::mt19937 rng{7};
+    std::vector<int> keys;
+    keys.reserve(COUNT + OPERATIONS);
+
+    std::size_t calls = bench::allocations();
+    bench::Timer timer;
+    {
+        Tree tree;
+        for (int i = 0; i < COUNT; ++i) {
+            keys.push_back(static_cast<int>(rng()));
+            tree.insert(keys.back());
+        }
+        bench::report(name + ", build", timer.ns() / 1e6, "ms");
+        bench::report(name + ", build allocations",
+                      static_cast<double>(bench::allocations() - calls), "");
+
+        calls = bench::allocations();
+        timer = bench::Timer();
+        for (int k = 0; k < OPERATIONS; ++k) {
+            if (rng() % 2) {
+                keys.push_back(static_cast<int>(rng()));
+                tree.insert(keys.back());
+            } else {
+                std::size_t i = rng() % keys.size();
+                tree.remove(keys[i]);
+                keys[i] = keys.back();
+                keys.pop_back();
+            }
+        }
+        bench::report(name + ", mixed", timer.ns() / OPERATIONS, "ns/op");
+        bench::report(name + ", mixed allocations",
+                      static_cast<double>(bench::allocations() - calls), "");
+
+        timer = bench::Timer();
+        std::int64_t sum = 0;
+        for (int x : tree)
+            sum += x;
+        bench::keep(sum);
+        bench::report(name + ", traverse", timer.ns() / 1e6, "ms");
+
+        timer = bench::Timer();
+    }
+    bench::report(name + ", destroy", timer.ns() / 1e6, "ms");
+}
+
+} // namespace
+
+int main() {
+    run<AVL<int, DefaultComparator<int>, AVLHeapAllocator>>("heap");
+    run<AVL<int>>("pool");
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+// Compares pone::FlatHashMap against std::unordered_map on the two key
+// shapes a board indexes: tile names (1M string keys, looked up by
+// std::string_view) and packed (x, y) coordinates of a 1k x 1k grid.
+
+#include "bench.hpp"
+#include "utils/flat_hash_map.h"
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace pone;
+
+namespace {
+
+constexpr int COUNT = 1000000;
+constexpr int PROBES = 2000000;
+
+struct CoordHash {
+    std::size_t operator()(const std::pair<int, int> &c) const {
+        return FlatHash<std::pair<int, int>>{}(c);
+    }
+};
+
+using Coord = std::pair<int, int>;
+
+template <typename Map, typename Key>
+void run(const char *label, const std::vector<Key> &keys,
+         const std::vector<Key> &probes) {
+    std::string name = label;
+
+    std::size_t calls = bench::allocations(), before = bench::liveBytes();
+    bench::Timer timer;
+    Map map;
+    map.reserve(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        map.emplace(keys[i], static_cast<int>(i));
+    bench::report(name + " insert", timer.ns() / keys.size(), "ns/op");
+    bench::report(name + " heap",
+                  static_cast<double>(bench::liveBytes() - before) /
+                      keys.size(),
+                  "bytes/entry");
+    bench::report(name + " allocations",
+                  static_cast<double>(bench::allocations() - calls), "");
+
+    // Half of the probes miss.
+    long sum = 0;
+    timer = bench::Timer();
+    for (const Key &k : probes) {
+        auto it = map.find(k);
+        if (it != map.end())
+            sum += it->second;
+    }
+    bench::keep(sum);
+    bench::report(name + " find", timer.ns() / probes.size(), "ns/op");
+
+    timer = bench::Timer();
+    for (std::size_t i = 0; i < keys.size(); i += 2)
+        map.erase(keys[i]);
+    bench::report(name + " erase", timer.ns() / (keys.size() / 2), "ns/op");
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng{5};
+
+    std::vector<std::string> names(COUNT), nameProbes(PROBES);
+    for (int i = 0; i < COUNT; ++i)
+        names[i] = "t" + std::to_string(i);
+    for (std::string &p : nameProbes)
+        p = "t" + std::to_string(rng() % (2 * COUNT));
+
+    run<std::unordered_map<std::string, int>>("unordered_map<string>", names,
+                                              nameProbes);
+    run<FlatHashMap<std::string, int>>("FlatHashMap<string>", names,
+                                       nameProbes);
+
+    std::vector<Coord> coords(COUNT), coordProbes(PROBES);
+    for (int i = 0; i < COUNT; ++i)
+        coords[i] = Coord{i % 1000, i / 1000};
+    for (Coord &p : coordProbes)
+        p = Coord{static_cast<int>(rng() % 1000),
+                  static_cast<int>(rng() % 2000)};
+
+    run<std::unordered_map<Coord, int, CoordHash>>("unordered_map<coord>",
+                                                   coords, coordProbes);
+    run<FlatHashMap<Coord, int>>("FlatHashMap<coord>", coords, coordProbes);
+
+    return 0;
+}
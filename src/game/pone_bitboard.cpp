@@ -0,0 +1,584 @@
+/*   Created:    2026-10-17
+ *   Modified:   2026-10-17
+ */
+
+#include "pone_bitboard.hpp"
+#include "pone_const.hpp"
+#include "pone_except.hpp"
+#include <algorithm>
+#include <format>
+
+namespace pone {
+
+namespace {
+
+/**
+ * Gets the bit of a column.
+ *
+ * @param x the column, 0 <= x < 64.
+ * @return the bit of the column.
+ */
+std::uint64_t bit(const int &x) {
+    return std::uint64_t{1} << x;
+}
+
+/**
+ * Gets the cell of a coordinate pair.
+ *
+ * @param x the horizontal position.
+ * @param y the vertical position.
+ * @return the cell, y * MAX_SIZE + x.
+ */
+int cellIndex(const int &x, const int &y) {
+    return y * BitBoard::MAX_SIZE + x;
+}
+
+/**
+ * Gets the direction an arrow points to after a rotation.
+ *
+ * @param d the direction before the rotation.
+ * @param r the rotation.
+ * @return the direction after the rotation.
+ */
+Direction rotated(const Direction &d, const Rotation &r) {
+    // Indexed by Direction: UP, DOWN, LEFT, RIGHT.
+    static constexpr Direction CW[] = {RIGHT, LEFT, UP, DOWN};
+    static constexpr Direction CCW[] = {LEFT, RIGHT, DOWN, UP};
+    return r == CLOCKWISE ? CW[d] : CCW[d];
+}
+
+} // namespace
+
+// +----------------------------------+
+// + BitBoard constructors            +
+// +----------------------------------+
+
+BitBoard::BitBoard(const std::string &name, const int &length,
+                   const int &width, const int &cursor_x, const int &cursor_y)
+    : m_name{name}, m_length{length}, m_width{width}, m_numTiles{0},
+      m_cursorX{cursor_x}, m_cursorY{cursor_y}, m_tiles{}, m_collision{},
+      m_goal{}, m_directions{}, m_eastGates{}, m_northGates{},
+      m_eastActive{}, m_northActive{} {
+    if (length < 0 || width < 0 || length > MAX_SIZE || width > MAX_SIZE) {
+        ErrorMessage INVAL_DIM{
+            name::PONE_GLOBAL_NAME, name::BITBOARD_BITBOARD1,
+            std::format("A bitboard cannot be {}x{} tiles.", length, width)};
+        throw InvalidBoardException(INVAL_DIM);
+    }
+}
+
+BitBoard::BitBoard(const Board &board)
+    : BitBoard(board.getName(), std::min(board.getLength(), MAX_SIZE),
+               std::min(board.getWidth(), MAX_SIZE)) {
+    if (board.getLength() > MAX_SIZE || board.getWidth() > MAX_SIZE) {
+        ErrorMessage INVAL_DIM{
+            name::PONE_GLOBAL_NAME, name::BITBOARD_BITBOARD2,
+            std::format("A bitboard cannot be {}x{} tiles.",
+                        board.getLength(), board.getWidth())};
+        throw InvalidBoardException(INVAL_DIM);
+    }
+
+    for (int y = 0; y < m_width; ++y)
+        for (int x = 0; x < m_length; ++x)
+            if (TilePtr t = board.getTile(x, y))
+                add(t);
+
+    for (int y = 0; y < m_width; ++y) {
+        for (int x = 0; x < m_length; ++x) {
+            TilePtr t = board.getTile(x, y);
+            if (t == nullptr)
+                continue;
+
+            // A Board keeps the gates of a removed tile; they lead
+            // nowhere, so they are left out.
+            GatePtr g = board.getGate(t, RIGHT);
+            if (g != nullptr && board.getTile(t, RIGHT) != nullptr)
+                add(g);
+            g = board.getGate(t, UP);
+            if (g != nullptr && board.getTile(t, UP) != nullptr)
+                add(g);
+        }
+    }
+
+    if (TilePtr t = board.getCursorTile()) {
+        m_cursorX = t->getX();
+        m_cursorY = t->getY();
+    }
+}
+
+// +----------------------------------+
+// + BitBoard helpers                 +
+// +----------------------------------+
+
+bool BitBoard::inBounds(const int &x, const int &y) const {
+    return x >= 0 && x < m_length && y >= 0 && y < m_width;
+}
+
+int BitBoard::edgeIndex(const TilePtr &t1, const TilePtr &t2) const {
+    if (t1 == nullptr || t2 == nullptr)
+        return -1;
+
+    int x1 = t1->getX(), y1 = t1->getY(), x2 = t2->getX(), y2 = t2->getY();
+    if (!inBounds(x1, y1) || !inBounds(x2, y2))
+        return -1;
+
+    if (y1 == y2 && (x2 - x1 == 1 || x1 - x2 == 1))
+        return 2 * cellIndex(std::min(x1, x2), y1);
+    else if (x1 == x2 && (y2 - y1 == 1 || y1 - y2 == 1))
+        return 2 * cellIndex(x1, std::min(y1, y2)) + 1;
+
+    return -1;
+}
+
+int BitBoard::tileCell(const TilePtr &t) const {
+    auto it = m_tileCells.find(t->getName());
+    if (it == m_tileCells.end() ||
+        it->second != cellIndex(t->getX(), t->getY()))
+        return -1;
+
+    return it->second;
+}
+
+TilePtr BitBoard::tileAt(const int &i) const {
+    int x = i % MAX_SIZE, y = i / MAX_SIZE;
+    auto t = std::make_shared<Tile>(m_tileCopies.find(i)->second);
+
+    // Arrows may have been rotated since the tile was added.
+    if (t->isDirection()) {
+        TileType type;
+        getTileType(x, y, type);
+        t->setTileType(type);
+    }
+    t->setCursor(x == m_cursorX && y == m_cursorY);
+    return t;
+}
+
+GatePtr BitBoard::gateAt(const int &e) const {
+    int x = (e >> 1) % MAX_SIZE, y = (e >> 1) / MAX_SIZE;
+    const BitRows &active = (e & 1) ? m_northActive : m_eastActive;
+    auto g = std::make_shared<Gate>(m_gateCopies.find(e)->second);
+
+    g->setTilePair({getTile(x, y), getTile(x + !(e & 1), y + (e & 1))});
+    if (active[y] & bit(x))
+        g->setActive();
+    else
+        g->setInactive();
+    return g;
+}
+
+std::uint64_t BitBoard::open(const int &y) const {
+    return m_tiles[y] & ~m_collision[y];
+}
+
+// +----------------------------------+
+// + BitBoard functions               +
+// +----------------------------------+
+
+std::string BitBoard::getName() const {
+    return m_name;
+}
+
+int BitBoard::getLength() const {
+    return m_length;
+}
+
+int BitBoard::getWidth() const {
+    return m_width;
+}
+
+CoordPair BitBoard::getCursor() const {
+    return CoordPair{m_cursorX, m_cursorY};
+}
+
+void BitBoard::add(const TilePtr &t) {
+    if (t == nullptr || !inBounds(t->getX(), t->getY())) {
+        ErrorMessage T_INVAL{name::PONE_GLOBAL_NAME, name::BITBOARD_ADD1,
+                             "Tile is null or outside of the board."};
+        throw InvalidTileException(T_INVAL);
+    }
+
+    int x = t->getX(), y = t->getY();
+    if (m_tiles[y] & bit(x)) {
+        ErrorMessage T_DUP{
+            name::PONE_GLOBAL_NAME, name::BITBOARD_ADD1,
+            std::format("A tile already exists at ({}, {}).", x, y)};
+        throw DuplicateTilesException(T_DUP);
+    }
+
+    if (m_tileCells.contains(t->getName())) {
+        ErrorMessage T_DUP{
+            name::PONE_GLOBAL_NAME, name::BITBOARD_ADD1,
+            std::format("Tile \"{}\" already exists.", t->getName())};
+        throw DuplicateTilesException(T_DUP);
+    }
+
+    m_tiles[y] |= bit(x);
+    m_tileCopies.emplace(cellIndex(x, y), *t);
+    m_tileCells.emplace(t->getName(), cellIndex(x, y));
+    ++m_numTiles;
+
+    switch (t->getTileType()) {
+    case TileType::COLLISION:
+        m_collision[y] |= bit(x);
+        break;
+    case TileType::GOAL:
+        m_goal[y] |= bit(x);
+        break;
+    case TileType::UP:
+        m_directions[UP][y] |= bit(x);
+        break;
+    case TileType::DOWN:
+        m_directions[DOWN][y] |= bit(x);
+        break;
+    case TileType::LEFT:
+        m_directions[LEFT][y] |= bit(x);
+        break;
+    case TileType::RIGHT:
+        m_directions[RIGHT][y] |= bit(x);
+        break;
+    default:
+        break;
+    }
+
+    if (t->isDirection()) {
+        ColorID color = t->getColorID();
+        if (color >= m_colors.size())
+            m_colors.resize(color + 1, BitRows{});
+        m_colors[color][y] |= bit(x);
+    }
+}
+
+void BitBoard::add(const GatePtr &g) {
+    int e = g == nullptr ? -1 : edgeIndex(g->getTile1(), g->getTile2());
+
+    if (e < 0) {
+        ErrorMessage G_INVAL{name::PONE_GLOBAL_NAME, name::BITBOARD_ADD2,
+                             "Gate is not between two adjacent tiles."};
+        throw InvalidGateException(G_INVAL);
+    }
+
+    const TilePtr &t1 = g->getTile1(), &t2 = g->getTile2();
+    if (!(m_tiles[t1->getY()] & bit(t1->getX())) ||
+        !(m_tiles[t2->getY()] & bit(t2->getX()))) {
+        ErrorMessage G_EMPTY{
+            name::PONE_GLOBAL_NAME, name::BITBOARD_ADD2,
+            std::format("Gate \"{}\" leads to an empty cell.", g->getName())};
+        throw InvalidGateException(G_EMPTY);
+    } else if (m_gateCopies.contains(e) || m_gateEdges.contains(g->getName())) {
+        ErrorMessage G_DUP{
+            name::PONE_GLOBAL_NAME, name::BITBOARD_ADD2,
+            std::format("Gate \"{}\" already exists.", g->getName())};
+        throw DuplicateGatesException(G_DUP);
+    }
+
+    int x = (e >> 1) % MAX_SIZE, y = (e >> 1) / MAX_SIZE;
+    ((e & 1) ? m_northGates : m_eastGates)[y] |= bit(x);
+    if (g->isActive())
+        ((e & 1) ? m_northActive : m_eastActive)[y] |= bit(x);
+
+    Gate copy = *g;
+    copy.setTilePair({});
+    m_gateCopies.emplace(e, std::move(copy));
+    m_gateEdges.emplace(g->getName(), e);
+}
+
+void BitBoard::remove(const TilePtr &t) {
+    if (t == nullptr) {
+        ErrorMessage T_NULL{name::PONE_GLOBAL_NAME, name::BITBOARD_REM1,
+                            "Tile is null."};
+        throw InvalidTileException(T_NULL);
+    }
+
+    int i = tileCell(t);
+    if (i < 0) {
+        ErrorMessage T_NF{
+            name::PONE_GLOBAL_NAME, name::BITBOARD_REM1,
+            std::format("Tile \"{}\" was not found.", t->getName())};
+        throw InvalidTileException(T_NF);
+    }
+
+    int x = i % MAX_SIZE, y = i / MAX_SIZE;
+    std::uint64_t keep = ~bit(x);
+    ColorID color = m_tileCopies.find(i)->second.getColorID();
+
+    m_tiles[y] &= keep;
+    m_collision[y] &= keep;
+    m_goal[y] &= keep;
+    for (BitRows &rows : m_directions)
+        rows[y] &= keep;
+    if (color < m_colors.size())
+        m_colors[color][y] &= keep;
+
+    m_tileCells.erase(t->getName());
+    m_tileCopies.erase(i);
+    --m_numTiles;
+}
+
+void BitBoard::remove(const GatePtr &g) {
+    if (g == nullptr) {
+        ErrorMessage G_NULL{name::PONE_GLOBAL_NAME, name::BITBOARD_REM2,
+                            "Gate is null."};
+        throw InvalidGateException(G_NULL);
+    }
+
+    auto it = m_gateEdges.find(g->getName());
+    if (it == m_gateEdges.end()) {
+        ErrorMessage G_NF{
+            name::PONE_GLOBAL_NAME, name::BITBOARD_REM2,
+            std::format("Gate \"{}\" was not found.", g->getName())};
+        throw InvalidGateException(G_NF);
+    }
+
+    int e = it->second; // Erasing the name moves the entry.
+    int x = (e >> 1) % MAX_SIZE, y = (e >> 1) / MAX_SIZE;
+    ((e & 1) ? m_northGates : m_eastGates)[y] &= ~bit(x);
+    ((e & 1) ? m_northActive : m_eastActive)[y] &= ~bit(x);
+
+    m_gateEdges.erase(g->getName());
+    m_gateCopies.erase(e);
+}
+
+TilePtr BitBoard::getTile(const std::string &name) const {
+    auto it = m_tileCells.find(name);
+    return it == m_tileCells.end() ? nullptr : tileAt(it->second);
+}
+
+TilePtr BitBoard::getTile(const int &x, const int &y) const {
+    if (!inBounds(x, y) || !(m_tiles[y] & bit(x)))
+        return nullptr;
+
+    return tileAt(cellIndex(x, y));
+}
+
+GatePtr BitBoard::getGate(const std::string &name) const {
+    auto it = m_gateEdges.find(name);
+    return it == m_gateEdges.end() ? nullptr : gateAt(it->second);
+}
+
+GatePtr BitBoard::getGate(const TilePtr &t1, const TilePtr &t2) const {
+    if (t1 == nullptr || t2 == nullptr) {
+        ErrorMessage T_NULL{name::PONE_GLOBAL_NAME, name::BITBOARD_GETG,
+                            "Tile is null."};
+        throw InvalidTileException(T_NULL);
+    }
+
+    int e = edgeIndex(t1, t2);
+    if (e < 0 || !m_gateCopies.contains(e))
+        return nullptr;
+
+    return gateAt(e);
+}
+
+void BitBoard::setGateActive(const GatePtr &g, bool active) {
+    int e = g == nullptr ? -1 : edgeIndex(g->getTile1(), g->getTile2());
+
+    if (e < 0 || !m_gateCopies.contains(e)) {
+        ErrorMessage G_NF{name::PONE_GLOBAL_NAME, name::BITBOARD_SETGACTIVE,
+                          "Gate is not on the board."};
+        throw InvalidGateException(G_NF);
+    }
+
+    int x = (e >> 1) % MAX_SIZE, y = (e >> 1) / MAX_SIZE;
+    BitRows &rows = (e & 1) ? m_northActive : m_eastActive;
+    if (active)
+        rows[y] |= bit(x);
+    else
+        rows[y] &= ~bit(x);
+}
+
+bool BitBoard::empty() const {
+    return m_numTiles <= 0;
+}
+
+bool BitBoard::full() const {
+    return m_numTiles >= m_length * m_width;
+}
+
+// +----------------------------------+
+// + BitBoard game functions          +
+// +----------------------------------+
+
+void BitBoard::moveCursor(const Direction &d) {
+    int x = m_cursorX + (d == RIGHT) - (d == LEFT);
+    int y = m_cursorY + (d == UP) - (d == DOWN);
+
+    if (!inBounds(x, y) || !(m_tiles[y] & bit(x))) {
+        ErrorMessage T_NF{name::PONE_GLOBAL_NAME, name::BITBOARD_MVCSR,
+                          std::format("No tile at ({}, {}).", x, y)};
+        throw InvalidTileException(T_NF);
+    }
+
+    m_cursorX = x;
+    m_cursorY = y;
+}
+
+bool BitBoard::checkMove(const Direction &d) const {
+    int x = m_cursorX, y = m_cursorY;
+
+    switch (d) {
+    case UP:
+        return y + 1 < m_width && (open(y + 1) & bit(x)) &&
+               !(m_northActive[y] & bit(x));
+    case DOWN:
+        return y > 0 && (open(y - 1) & bit(x)) &&
+               !(m_northActive[y - 1] & bit(x));
+    case LEFT:
+        return x > 0 && (open(y) & bit(x - 1)) &&
+               !(m_eastActive[y] & bit(x - 1));
+    case RIGHT:
+        return x + 1 < m_length && (open(y) & bit(x + 1)) &&
+               !(m_eastActive[y] & bit(x));
+    default:
+        return false;
+    }
+}
+
+bool BitBoard::tryMoveCursor(const Direction &d) {
+    if (!checkMove(d))
+        return false;
+
+    m_cursorX += (d == RIGHT) - (d == LEFT);
+    m_cursorY += (d == UP) - (d == DOWN);
+    return true;
+}
+
+void BitBoard::rotateTiles(const std::string &color, const Rotation &r) {
+    ColorID id;
+    if (ColorRegistry::find(color, id))
+        rotateTiles(id, r);
+}
+
+void BitBoard::rotateTiles(const ColorID &id, const Rotation &r) {
+    if (id == NO_COLOR || id >= m_colors.size())
+        return;
+
+    const BitRows &mask = m_colors[id];
+    BitRows &up = m_directions[UP], &down = m_directions[DOWN];
+    BitRows &left = m_directions[LEFT], &right = m_directions[RIGHT];
+
+    for (int y = 0; y < m_width; ++y) {
+        std::uint64_t c = mask[y];
+        std::uint64_t u = up[y] & c, d = down[y] & c;
+        std::uint64_t l = left[y] & c, rt = right[y] & c;
+
+        if (r == CLOCKWISE) {
+            up[y] = (up[y] & ~c) | l;
+            right[y] = (right[y] & ~c) | u;
+            down[y] = (down[y] & ~c) | rt;
+            left[y] = (left[y] & ~c) | d;
+        } else {
+            up[y] = (up[y] & ~c) | rt;
+            left[y] = (left[y] & ~c) | u;
+            down[y] = (down[y] & ~c) | l;
+            right[y] = (right[y] & ~c) | d;
+        }
+    }
+}
+
+void BitBoard::rotateTile(const TilePtr &t, const Rotation &r) {
+    if (t == nullptr) {
+        ErrorMessage T_NULL{name::PONE_GLOBAL_NAME, name::BITBOARD_ROTT,
+                            "Tile is null."};
+        throw InvalidTileException(T_NULL);
+    }
+
+    int i = tileCell(t);
+    if (i < 0) {
+        ErrorMessage T_NF{
+            name::PONE_GLOBAL_NAME, name::BITBOARD_ROTT,
+            std::format("Tile \"{}\" was not found.", t->getName())};
+        throw InvalidTileException(T_NF);
+    }
+
+    int x = i % MAX_SIZE, y = i / MAX_SIZE;
+    for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+        if (m_directions[d][y] & bit(x)) {
+            m_directions[d][y] &= ~bit(x);
+            m_directions[rotated(d, r)][y] |= bit(x);
+            return;
+        }
+    }
+
+    ErrorMessage T_ND{name::PONE_GLOBAL_NAME, name::BITBOARD_ROTT,
+                      std::format("Tile \"{}\" is not a directional tile.",
+                                  t->getName())};
+    throw InvalidDirectionException(T_ND);
+}
+
+bool BitBoard::cursorOnGoal() const {
+    return inBounds(m_cursorX, m_cursorY) &&
+           (m_goal[m_cursorY] & bit(m_cursorX));
+}
+
+bool BitBoard::getTileType(const int &x, const int &y, TileType &type) const {
+    if (!inBounds(x, y) || !(m_tiles[y] & bit(x)))
+        return false;
+
+    // Types the bitboard does not track read as TileType::EMPTY.
+    if (m_collision[y] & bit(x))
+        type = TileType::COLLISION;
+    else if (m_goal[y] & bit(x))
+        type = TileType::GOAL;
+    else if (m_directions[UP][y] & bit(x))
+        type = TileType::UP;
+    else if (m_directions[DOWN][y] & bit(x))
+        type = TileType::DOWN;
+    else if (m_directions[LEFT][y] & bit(x))
+        type = TileType::LEFT;
+    else if (m_directions[RIGHT][y] & bit(x))
+        type = TileType::RIGHT;
+    else
+        type = TileType::EMPTY;
+
+    return true;
+}
+
+BitRows BitBoard::reachable() const {
+    BitRows seen{};
+    if (!inBounds(m_cursorX, m_cursorY))
+        return seen;
+
+    seen[m_cursorY] = bit(m_cursorX);
+
+    // Sweep the rows until nothing changes. Within a row, cells spread
+    // sideways through edges without an active gate; between rows,
+    // they spread through north edges without an active gate.
+    for (bool changed = true; changed;) {
+        changed = false;
+
+        for (int y = 0; y < m_width; ++y) {
+            std::uint64_t row = seen[y], openRow = open(y);
+
+            if (y > 0)
+                row |= seen[y - 1] & ~m_northActive[y - 1] & openRow;
+            if (y + 1 < m_width)
+                row |= seen[y + 1] & ~m_northActive[y] & openRow;
+
+            for (std::uint64_t prev = 0; prev != row;) {
+                prev = row;
+                std::uint64_t east = (row & ~m_eastActive[y]) << 1;
+                std::uint64_t west = (row >> 1) & ~m_eastActive[y];
+                row |= (east | west) & openRow;
+            }
+
+            if (row != seen[y]) {
+                seen[y] = row;
+                changed = true;
+            }
+        }
+    }
+
+    return seen;
+}
+
+bool BitBoard::goalReachable() const {
+    BitRows seen = reachable();
+
+    for (int y = 0; y < m_width; ++y)
+        if (seen[y] & m_goal[y])
+            return true;
+
+    return false;
+}
+
+} // namespace pone
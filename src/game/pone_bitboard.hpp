@@ -0,0 +1,357 @@
+/*   Created:    2026-10-17
+ *   Modified:   2026-10-17
+ */
+
+#pragma once
+
+#include "pone_board.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace pone {
+
+/**
+ * One bit per cell of a board up to 64 x 64 tiles.
+ * Row y holds the cells (0, y) to (63, y), with x as the bit index.
+ */
+using BitRows = std::array<std::uint64_t, 64>;
+
+/**
+ * Board backend for boards of at most 64 x 64 tiles that keeps every
+ * tile attribute as one 64-bit word per row. Moves, rotations and
+ * reachability run as shifts and masks over whole rows.
+ *
+ * @note A BitBoard mirrors the tiles and gates it is built from.
+ *       It does not keep pointers to them: lookups hand back fresh
+ *       copies that reflect the bitboard, and editing a copy does not
+ *       edit the bitboard.
+ */
+class BitBoard {
+    // +----------------------------------+
+    // + BitBoard data members            +
+    // +----------------------------------+
+
+    std::string m_name;
+    int m_length, m_width;
+    int m_numTiles;
+    int m_cursorX, m_cursorY;
+
+    BitRows m_tiles;         // Cells that hold a tile
+    BitRows m_collision;     // Collision tiles
+    BitRows m_goal;          // Goal tiles
+    BitRows m_directions[4]; // Directional tiles, indexed by Direction
+
+    // Directional tiles per ColorID.
+    std::vector<BitRows> m_colors;
+
+    // Gates on the edge toward x + 1 and toward y + 1 of each cell,
+    // and the subset of them that is active.
+    BitRows m_eastGates, m_northGates;
+    BitRows m_eastActive, m_northActive;
+
+    // Copies of the tiles and gates as they were added, by cell
+    // (y * MAX_SIZE + x) and by edge (2 * cell toward x + 1,
+    // 2 * cell + 1 toward y + 1), and their names. Tile types, gate
+    // states and the cursor are read back from the bits.
+    FlatHashMap<int, Tile> m_tileCopies;
+    FlatHashMap<int, Gate> m_gateCopies;
+    NameIndex m_tileCells, m_gateEdges;
+
+    // +----------------------------------+
+    // + BitBoard helpers                 +
+    // +----------------------------------+
+
+    /**
+     * Checks if a coordinate pair lies within the board.
+     *
+     * @param x the horizontal position.
+     * @param y the vertical position.
+     *
+     * @return true if the cell is on the board, otherwise false.
+     */
+    bool inBounds(const int &x, const int &y) const;
+
+    /**
+     * Gets the edge between the cells of two tiles.
+     *
+     * @param t1 the first tile.
+     * @param t2 the second tile.
+     *
+     * @return the edge, or -1 if the tiles are not adjacent cells
+     *         of the board.
+     */
+    int edgeIndex(const TilePtr &t1, const TilePtr &t2) const;
+
+    /**
+     * Gets the cell of a tile on the board, matched by name and
+     * coordinates.
+     *
+     * @param t the tile.
+     *
+     * @return the cell, or -1 if the tile is not on the board.
+     */
+    int tileCell(const TilePtr &t) const;
+
+    /**
+     * Rebuilds the tile of a cell from its copy and the bits.
+     *
+     * @param i the cell, which holds a tile.
+     * @return a copy of the tile.
+     */
+    TilePtr tileAt(const int &i) const;
+
+    /**
+     * Rebuilds the gate of an edge from its copy and the bits.
+     *
+     * @param e the edge, which holds a gate.
+     * @return a copy of the gate, between copies of its tiles.
+     */
+    GatePtr gateAt(const int &e) const;
+
+    /**
+     * Gets the cells that can be entered: tiles that are not collisions.
+     *
+     * @param y the row.
+     * @return the row of open cells.
+     */
+    std::uint64_t open(const int &y) const;
+
+  public:
+    /**
+     * The largest length and width of a BitBoard.
+     */
+    static constexpr int MAX_SIZE = 64;
+
+    // +----------------------------------+
+    // + BitBoard constructors            +
+    // +----------------------------------+
+
+    /**
+     * Constructs an empty bitboard with a name and size.
+     *
+     * @param name the name of the board.
+     * @param length the length of the board, at most MAX_SIZE.
+     * @param width the width of the board, at most MAX_SIZE.
+     * @param cursor_x the horizontal position of the cursor.
+     * @param cursor_y the vertical position of the cursor.
+     */
+    BitBoard(const std::string &name, const int &length, const int &width,
+             const int &cursor_x = 0, const int &cursor_y = 0);
+
+    /**
+     * Constructs a bitboard mirroring every tile and gate of a board.
+     *
+     * @param board a board of at most MAX_SIZE x MAX_SIZE tiles.
+     */
+    explicit BitBoard(const Board &board);
+
+    // +----------------------------------+
+    // + BitBoard functions               +
+    // +----------------------------------+
+
+    /**
+     * Gets the name of the board.
+     *
+     * @return the name of the board.
+     */
+    std::string getName() const;
+
+    /**
+     * Gets the length of the board.
+     *
+     * @return the length.
+     */
+    int getLength() const;
+
+    /**
+     * Gets the width of the board.
+     *
+     * @return the width.
+     */
+    int getWidth() const;
+
+    /**
+     * Gets the coordinates of the cursor.
+     *
+     * @return the coordinate pair of the cursor.
+     */
+    CoordPair getCursor() const;
+
+    /**
+     * Mirrors a tile into the board.
+     *
+     * @param t the tile to add.
+     */
+    void add(const TilePtr &t);
+
+    /**
+     * Mirrors a gate into the board.
+     * Both of its tiles must be adjacent and already on the board.
+     *
+     * @param g the gate to add.
+     */
+    void add(const GatePtr &g);
+
+    /**
+     * Removes a tile from the board.
+     * Gates along its edges stay, as they do on a Board.
+     *
+     * @param t the tile to remove, matched by name and coordinates.
+     */
+    void remove(const TilePtr &t);
+
+    /**
+     * Removes a gate from the board.
+     *
+     * @param g the gate to remove, matched by name.
+     */
+    void remove(const GatePtr &g);
+
+    /**
+     * Gets a copy of the tile with a name.
+     *
+     * @param name the name of the tile.
+     * @return the tile, or nullptr if there is none.
+     */
+    TilePtr getTile(const std::string &name) const;
+
+    /**
+     * Gets a copy of the tile at a cell.
+     *
+     * @param x the horizontal position.
+     * @param y the vertical position.
+     * @return the tile, or nullptr if the cell is empty.
+     */
+    TilePtr getTile(const int &x, const int &y) const;
+
+    /**
+     * Gets a copy of the gate with a name.
+     *
+     * @param name the name of the gate.
+     * @return the gate, or nullptr if there is none.
+     */
+    GatePtr getGate(const std::string &name) const;
+
+    /**
+     * Gets a copy of the gate between the cells of two tiles.
+     *
+     * @param t1 the first tile.
+     * @param t2 the second tile.
+     * @return the gate, or nullptr if there is none.
+     */
+    GatePtr getGate(const TilePtr &t1, const TilePtr &t2) const;
+
+    /**
+     * Turns the gate between two adjacent tiles on or off.
+     *
+     * @param g the gate.
+     * @param active true to turn the gate on, false to turn it off.
+     */
+    void setGateActive(const GatePtr &g, bool active);
+
+    /**
+     * Checks if the board has no tiles.
+     *
+     * @return true if the board is empty, otherwise false.
+     */
+    bool empty() const;
+
+    /**
+     * Checks if the board has length * width tiles.
+     *
+     * @return true if every cell holds a tile, otherwise false.
+     */
+    bool full() const;
+
+    // +----------------------------------+
+    // + BitBoard game functions          +
+    // +----------------------------------+
+
+    /**
+     * Moves the cursor one tile to a specified direction.
+     *
+     * @param d the direction to move towards.
+     */
+    void moveCursor(const Direction &d);
+
+    /**
+     * Checks if the next move toward a specified direction is valid.
+     *
+     * @param d the direction to check.
+     *
+     * @return true if the move is valid, otherwise false.
+     */
+    bool checkMove(const Direction &d) const;
+
+    /**
+     * Moves the cursor one tile to a specified direction
+     * if checkMove allows it.
+     *
+     * @param d the direction to move towards.
+     *
+     * @return true if the cursor moved, otherwise false.
+     */
+    bool tryMoveCursor(const Direction &d);
+
+    /**
+     * Rotates every directional tile of a color.
+     *
+     * @param color the color of the tiles.
+     * @param r the rotation to apply to the tiles.
+     */
+    void rotateTiles(const std::string &color, const Rotation &r);
+
+    /**
+     * Rotates every directional tile of an interned color,
+     * without a registry lookup.
+     *
+     * @param color the color of the tiles.
+     * @param r the rotation to apply to the tiles.
+     */
+    void rotateTiles(const ColorID &color, const Rotation &r);
+
+    /**
+     * Rotates one directional tile.
+     *
+     * @param t the tile to rotate, matched by name and coordinates.
+     * @param r the rotation to apply to the tile.
+     */
+    void rotateTile(const TilePtr &t, const Rotation &r);
+
+    /**
+     * Checks if the cursor is on the goal.
+     *
+     * @return true if the cursor is on the goal, otherwise false.
+     */
+    bool cursorOnGoal() const;
+
+    /**
+     * Gets the type of the tile at a cell as the bitboard sees it.
+     *
+     * @param x the horizontal position.
+     * @param y the vertical position.
+     * @param type set to the type if a tile was found.
+     *
+     * @return true if the cell holds a tile, otherwise false.
+     */
+    bool getTileType(const int &x, const int &y, TileType &type) const;
+
+    /**
+     * Flood fills every cell the cursor can reach with valid moves.
+     *
+     * @return one bit per reachable cell.
+     */
+    BitRows reachable() const;
+
+    /**
+     * Checks if the cursor can reach any goal tile.
+     *
+     * @return true if a goal is reachable, otherwise false.
+     */
+    bool goalReachable() const;
+};
+
+static_assert(BoardBackend<BitBoard>);
+
+} // namespace pone
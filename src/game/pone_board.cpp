@@ -1,32 +1,956 @@
 /*   Created:    2024-06-23
- *   Modified:   2026-05-04
+ *   Modified:   2026-10-17
  */
 
 #include "pone_board.hpp"
 #include "pone_const.hpp"
 #include "pone_except.hpp"
 #include "utils/except.h"
+#include "utils/hash.h"
+#include <algorithm>
+#include <atomic>
 #include <format>
 #include <stdexcept>
 
 namespace pone {
 
+namespace {
+
+/**
+ * Gets the horizontal offset of a direction.
+ *
+ * @param d the direction.
+ * @return -1, 0 or 1.
+ */
+int directionDX(const Direction &d) {
+    return (d == RIGHT) - (d == LEFT);
+}
+
+/**
+ * Gets the vertical offset of a direction.
+ *
+ * @param d the direction.
+ * @return -1, 0 or 1.
+ */
+int directionDY(const Direction &d) {
+    return (d == UP) - (d == DOWN);
+}
+
+/**
+ * Checks if a direction is one of the four enumerators.
+ *
+ * @param d the direction.
+ * @return true if the direction is valid, otherwise false.
+ */
+bool validDirection(const Direction &d) {
+    return d == UP || d == DOWN || d == LEFT || d == RIGHT;
+}
+
+/**
+ * Gets the gate mask bit of a direction.
+ *
+ * @param d the direction.
+ * @return the bit marking the edge of a cell toward d.
+ */
+unsigned char edgeBit(const Direction &d) {
+    return static_cast<unsigned char>(1 << d);
+}
+
+/**
+ * Gets the opposite of a direction.
+ *
+ * @param d the direction.
+ * @return UP for DOWN, LEFT for RIGHT, and so on.
+ */
+Direction opposite(const Direction &d) {
+    return static_cast<Direction>(d ^ 1); // Pairs are adjacent in Direction
+}
+
+/**
+ * Offset of the active edge bits within a gate mask.
+ */
+constexpr int ACTIVE_SHIFT = 4;
+
+/**
+ * Tags that keep the Zobrist keys of tiles, gates and the cursor apart.
+ */
+enum ZobristTag : std::uint64_t { ZOBRIST_TILE, ZOBRIST_GATE, ZOBRIST_CURSOR };
+
+/**
+ * Rotates a directional tile type.
+ *
+ * @param type a directional tile type.
+ * @param r the rotation to apply.
+ * @return the rotated tile type.
+ */
+TileType rotateType(const TileType &type, const Rotation &r) {
+    bool cw = r == CLOCKWISE;
+
+    switch (type) {
+    case TileType::UP:
+        return cw ? TileType::RIGHT : TileType::LEFT;
+    case TileType::RIGHT:
+        return cw ? TileType::DOWN : TileType::UP;
+    case TileType::DOWN:
+        return cw ? TileType::LEFT : TileType::RIGHT;
+    case TileType::LEFT:
+        return cw ? TileType::UP : TileType::DOWN;
+    default:
+        return type;
+    }
+}
+
+/**
+ * Gets the rotation that replays a journaled rotation.
+ *
+ * @param arg the journaled Rotation.
+ * @param inverse true to get the rotation that reverts it.
+ * @return the rotation to apply.
+ */
+Rotation replayRotation(const unsigned char &arg, bool inverse) {
+    bool cw = (arg == CLOCKWISE) != inverse;
+    return cw ? CLOCKWISE : COUNTER_CLOCKWISE;
+}
+
+/**
+ * Gets a new board epoch. Epochs start at 1, so that 0 never
+ * matches the epoch of a board.
+ *
+ * @return the epoch.
+ */
+std::uint32_t nextEpoch() {
+    static std::atomic<std::uint32_t> epoch{0};
+    return ++epoch;
+}
+
+/**
+ * Makes a shared object private to its owner, copying it if
+ * anything else shares it.
+ *
+ * @param p the owner's pointer to the object.
+ * @return the private object.
+ */
+template <typename T> T &unshare(std::shared_ptr<T> &p) {
+    if (p.use_count() != 1)
+        p = std::make_shared<T>(*p);
+
+    // The last other owner may have been a board on another thread:
+    // see its reads before writing in place.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return *p;
+}
+
+/**
+ * Gets the slot of a cell within its chunk.
+ *
+ * @param i the cell index.
+ * @return the slot.
+ */
+int cellSlot(const int &i) {
+    return i & (BoardChunk::SIZE - 1);
+}
+
+/**
+ * Gets the slot of an edge within the chunk of its cell.
+ *
+ * @param e the edge index.
+ * @return the slot.
+ */
+int edgeSlot(const int &e) {
+    return e & (2 * BoardChunk::SIZE - 1);
+}
+
+// Read in place of chunks that have not been allocated.
+const BoardChunk EMPTY_CHUNK{};
+
+// Once more than one cell in CHANGE_RATIO has changed between two
+// drains, a rescan is about as cheap as the records: report a reset.
+constexpr std::size_t CHANGE_RATIO = 8;
+
+} // namespace
+
 // +----------------------------------+
 // + Board constructors               +
 // +----------------------------------+
 
-Board::Board()
-    : m_name{""}, m_length{0}, m_width{0}, m_numGates{0}, m_numTiles{0},
-      m_cursor{Cursor{0, 0}} {}
+Board::Board() : Board("", 0, 0) {}
 
 Board::Board(const std::string &name, const int &length, const int &width)
-    : m_name{name}, m_length{length}, m_width{width}, m_numGates{0},
-      m_numTiles{0}, m_cursor{Cursor{0, 0}} {}
+    : Board(name, length, width, 0, 0) {}
 
 Board::Board(const std::string &name, const int &length, const int &width,
              const int &cursor_x, const int &cursor_y)
-    : m_name{name}, m_length{length}, m_width{width}, m_numGates{0},
-      m_numTiles{0}, m_cursor{Cursor{cursor_x, cursor_y}} {}
+    : m_name{name}, m_length{0}, m_width{0},
+      m_chunks{std::make_shared<ChunkTable>()}, m_chunkColumns{0},
+      m_version{0}, m_changesReset{true}, m_componentsValid{false},
+      m_numGates{0}, m_numTiles{0},
+      m_hash{0}, m_cursor{Cursor{cursor_x, cursor_y}}, m_epoch{nextEpoch()},
+      m_generation{0}, m_journalCapacity{DEFAULT_JOURNAL_CAPACITY},
+      m_journalHead{0}, m_journalEnd{0}, m_journalPos{0}, m_replaying{false} {
+    if (length < 0 || width < 0) {
+        ErrorMessage INVAL_DIM{
+            name::PONE_GLOBAL_NAME, name::BOARD_BOARD3,
+            std::format("Invalid board dimensions {}x{}.", length, width)};
+        throw InvalidValueException(INVAL_DIM);
+    }
+
+    resize(length, width);
+}
+
+Board::Board(const Board &other)
+    : m_name{other.m_name}, m_length{other.m_length},
+      m_width{other.m_width}, m_chunks{other.m_chunks},
+      m_chunkColumns{other.m_chunkColumns},
+      m_tileNamesMap{other.m_tileNamesMap},
+      m_gateNamesMap{other.m_gateNamesMap},
+      m_colorBuckets{other.m_colorBuckets},
+      m_dirtyChunks{other.m_dirtyChunks}, m_version{other.m_version},
+      m_changesReset{true}, m_componentsValid{false},
+      m_numGates{other.m_numGates},
+      m_numTiles{other.m_numTiles}, m_hash{other.m_hash},
+      m_cursor{other.m_cursor}, m_epoch{nextEpoch()},
+      m_generation{other.m_generation},
+      m_journalCapacity{other.m_journalCapacity}, m_journalHead{0},
+      m_journalEnd{0}, m_journalPos{0}, m_replaying{false} {
+    // The tiles and gates are shared now: neither board owns them.
+    // Readers of a published board may copy it at the same time.
+    std::atomic_ref<std::uint32_t>{other.m_epoch}.store(
+        nextEpoch(), std::memory_order_relaxed);
+}
+
+Board &Board::operator=(const Board &other) {
+    if (this != &other)
+        *this = Board{other};
+    return *this;
+}
+
+// +----------------------------------+
+// + Board grid helpers               +
+// +----------------------------------+
+
+bool Board::inBounds(const int &x, const int &y) const {
+    return x >= 0 && x < m_length && y >= 0 && y < m_width;
+}
+
+int Board::cellIndex(const int &x, const int &y) const {
+    constexpr int SIDE_SHIFT = BoardChunk::SIDE_SHIFT;
+    constexpr int MASK = BoardChunk::SIDE - 1;
+
+    int k = (y >> SIDE_SHIFT) * m_chunkColumns + (x >> SIDE_SHIFT);
+    return (k << BoardChunk::SHIFT) | ((y & MASK) << SIDE_SHIFT) | (x & MASK);
+}
+
+int Board::cellX(const int &i) const {
+    int k = i >> BoardChunk::SHIFT;
+    return (k % m_chunkColumns) * BoardChunk::SIDE +
+           (i & (BoardChunk::SIDE - 1));
+}
+
+int Board::cellY(const int &i) const {
+    int k = i >> BoardChunk::SHIFT;
+    return (k / m_chunkColumns) * BoardChunk::SIDE +
+           ((i >> BoardChunk::SIDE_SHIFT) & (BoardChunk::SIDE - 1));
+}
+
+int Board::cellLimit() const {
+    return static_cast<int>(m_chunks->size()) << BoardChunk::SHIFT;
+}
+
+void Board::markDirty(const std::size_t &k) {
+    std::uint64_t bit = std::uint64_t{1} << (k % 64);
+    if (!((*m_dirtyChunks)[k / 64] & bit))
+        unshare(m_dirtyChunks)[k / 64] |= bit;
+}
+
+void Board::touchCell(const int &i, const unsigned char &changed) {
+    ++m_version;
+    if (m_changesReset)
+        return;
+
+    unsigned char &flags = m_changeFlags[i];
+    if (flags == 0) {
+        if (m_changedCells.size() >= m_changeFlags.size() / CHANGE_RATIO) {
+            resetChanges();
+            return;
+        }
+        m_changedCells.push_back(i);
+    }
+    flags |= changed;
+}
+
+void Board::touchEdge(const int &e) {
+    touchCell(e / 2, e % 2 ? BoardChangeRecord::GATE_UP
+                           : BoardChangeRecord::GATE_RIGHT);
+}
+
+void Board::resetChanges() {
+    ++m_version;
+    m_changesReset = true;
+    m_changedCells = {};
+    m_changeFlags = {};
+}
+
+int Board::edgeIndex(const int &x1, const int &y1, const int &x2,
+                     const int &y2) const {
+    if (!inBounds(x1, y1) || !inBounds(x2, y2))
+        return -1;
+
+    // Edges are owned by the cell with the lower coordinate.
+    if (y1 == y2 && x2 == x1 + 1)
+        return 2 * cellIndex(x1, y1);
+    else if (y1 == y2 && x1 == x2 + 1)
+        return 2 * cellIndex(x2, y2);
+    else if (x1 == x2 && y2 == y1 + 1)
+        return 2 * cellIndex(x1, y1) + 1;
+    else if (x1 == x2 && y1 == y2 + 1)
+        return 2 * cellIndex(x2, y2) + 1;
+
+    return -1;
+}
+
+void Board::resize(const int &length, const int &width) {
+    int count = cellLimit();
+
+    for (int i = 0; i < count; ++i) {
+        const TilePtr &t = cell(i);
+        if (t == nullptr)
+            continue;
+        int x = t->getX(), y = t->getY();
+        if (x >= length || y >= width) {
+            ErrorMessage T_OOB{
+                name::PONE_GLOBAL_NAME, name::BOARD_SETL,
+                std::format("Tile \"{}\" would fall outside of the board.",
+                            t->getName())};
+            throw InvalidBoardException(T_OOB);
+        }
+    }
+
+    for (int e = 0; e < 2 * count; ++e) {
+        const GatePtr &g = edge(e);
+        if (g == nullptr)
+            continue;
+        const TilePtr &t1 = g->getTile1(), &t2 = g->getTile2();
+        if (std::max(t1->getX(), t2->getX()) >= length ||
+            std::max(t1->getY(), t2->getY()) >= width) {
+            ErrorMessage G_OOB{
+                name::PONE_GLOBAL_NAME, name::BOARD_SETL,
+                std::format("Gate \"{}\" would fall outside of the board.",
+                            g->getName())};
+            throw InvalidBoardException(G_OOB);
+        }
+    }
+
+    int columns = (length + BoardChunk::SIDE - 1) / BoardChunk::SIDE;
+    int rows = (width + BoardChunk::SIDE - 1) / BoardChunk::SIDE;
+    std::size_t chunks = static_cast<std::size_t>(columns) * rows;
+    ++m_generation;
+
+    std::shared_ptr<ChunkTable> oldChunks = std::move(m_chunks);
+    m_chunks = std::make_shared<ChunkTable>(chunks);
+    m_chunkColumns = columns;
+    m_length = length;
+    m_width = width;
+    m_tileNamesMap = std::make_shared<NameIndex>();
+    m_gateNamesMap = std::make_shared<NameIndex>();
+    m_colorBuckets = std::make_shared<ColorBuckets>();
+
+    // The whole board has moved, so all of it needs redrawing.
+    m_dirtyChunks =
+        std::make_shared<std::vector<std::uint64_t>>((chunks + 63) / 64);
+    for (std::size_t k = 0; k < chunks; ++k)
+        markDirty(k);
+    resetChanges();
+    m_componentsValid = false;
+
+    // Tiles and gates keep their owners, they are only moved around.
+    for (int i = 0; i < count; ++i) {
+        const std::shared_ptr<BoardChunk> &c =
+            (*oldChunks)[i >> BoardChunk::SHIFT];
+        if (c == nullptr) {
+            i |= BoardChunk::SIZE - 1; // Skip the whole chunk.
+            continue;
+        }
+
+        const BoardChunk &from = *c;
+        const TilePtr &t = from.cells[cellSlot(i)];
+        if (t == nullptr)
+            continue;
+        int j = cellIndex(t->getX(), t->getY());
+        BoardChunk &to = writableChunk(j);
+        to.cells[cellSlot(j)] = t;
+        to.types[cellSlot(j)] = from.types[cellSlot(i)];
+        to.tileOwners[cellSlot(j)] = from.tileOwners[cellSlot(i)];
+        (*m_tileNamesMap)[t->getName()] = j;
+        bucketTile(j);
+    }
+
+    for (int e = 0; e < 2 * count; ++e) {
+        const std::shared_ptr<BoardChunk> &c =
+            (*oldChunks)[e >> (BoardChunk::SHIFT + 1)];
+        if (c == nullptr) {
+            e |= 2 * BoardChunk::SIZE - 1;
+            continue;
+        }
+
+        const BoardChunk &from = *c;
+        const GatePtr &g = from.gateEdges[edgeSlot(e)];
+        if (g == nullptr)
+            continue;
+        const TilePtr &t1 = g->getTile1(), &t2 = g->getTile2();
+        int f = edgeIndex(t1->getX(), t1->getY(), t2->getX(), t2->getY());
+        BoardChunk &to = writableChunk(f / 2);
+        to.gateEdges[edgeSlot(f)] = g;
+        to.gateOwners[edgeSlot(f)] = from.gateOwners[edgeSlot(e)];
+        (*m_gateNamesMap)[g->getName()] = f;
+        updateGateMasks(f);
+    }
+
+    linkAll();
+    rehash();
+    clearJournal(); // Cell and edge indices have moved.
+}
+
+const BoardChunk &Board::chunk(const int &i) const {
+    const std::shared_ptr<BoardChunk> &c = (*m_chunks)[i >> BoardChunk::SHIFT];
+    return c == nullptr ? EMPTY_CHUNK : *c;
+}
+
+BoardChunk &Board::writableChunk(const int &i) {
+    std::size_t k = i >> BoardChunk::SHIFT;
+    std::shared_ptr<BoardChunk> &c = unshare(m_chunks)[k];
+    if (c == nullptr)
+        c = std::make_shared<BoardChunk>(m_generation);
+
+    markDirty(k);
+    return unshare(c);
+}
+
+const TilePtr &Board::cell(const int &i) const {
+    return chunk(i).cells[cellSlot(i)];
+}
+
+const GatePtr &Board::edge(const int &e) const {
+    return chunk(e / 2).gateEdges[edgeSlot(e)];
+}
+
+const TilePtr &Board::writableTile(const int &i) {
+    BoardChunk &c = writableChunk(i);
+    int slot = cellSlot(i);
+
+    if (c.tileOwners[slot] != m_epoch) {
+        c.cells[slot] = std::make_shared<Tile>(*c.cells[slot]);
+        c.tileOwners[slot] = m_epoch;
+    }
+
+    return c.cells[slot];
+}
+
+const GatePtr &Board::writableGate(const int &e) {
+    BoardChunk &c = writableChunk(e / 2);
+    int slot = edgeSlot(e);
+
+    if (c.gateOwners[slot] != m_epoch) {
+        c.gateEdges[slot] = std::make_shared<Gate>(*c.gateEdges[slot]);
+        c.gateOwners[slot] = m_epoch;
+    }
+
+    return c.gateEdges[slot];
+}
+
+int Board::neighborCell(const int &i, const Direction &d) const {
+    constexpr int SIDE = BoardChunk::SIDE, SIZE = BoardChunk::SIZE;
+    int column = i & (SIDE - 1);
+    int row = (i >> BoardChunk::SIDE_SHIFT) & (SIDE - 1);
+
+    // Step within the chunk, or into the same row or column of the
+    // next chunk over.
+    switch (d) {
+    case RIGHT:
+        return column != SIDE - 1 ? i + 1 : i + SIZE - (SIDE - 1);
+    case LEFT:
+        return column != 0 ? i - 1 : i - SIZE + (SIDE - 1);
+    case UP:
+        return row != SIDE - 1 ? i + SIDE
+                               : i + m_chunkColumns * SIZE - (SIZE - SIDE);
+    default:
+        return row != 0 ? i - SIDE : i - m_chunkColumns * SIZE + (SIZE - SIDE);
+    }
+}
+
+int Board::cellEdge(const int &i, const Direction &d) const {
+    switch (d) {
+    case RIGHT:
+        return 2 * i;
+    case UP:
+        return 2 * i + 1;
+    case LEFT:
+        return 2 * neighborCell(i, LEFT);
+    default:
+        return 2 * neighborCell(i, DOWN) + 1;
+    }
+}
+
+unsigned char Board::neighborMask(const int &i) const {
+    int x = cellX(i), y = cellY(i);
+    unsigned char mask = 0;
+
+    for (Direction d : {UP, DOWN, LEFT, RIGHT})
+        if (inBounds(x + directionDX(d), y + directionDY(d)) &&
+            cell(neighborCell(i, d)) != nullptr)
+            mask |= edgeBit(d);
+
+    return mask;
+}
+
+void Board::linkCell(const int &i, bool present) {
+    unsigned char mask = neighborMask(i);
+
+    for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+        if (!(mask & edgeBit(d)))
+            continue;
+
+        int j = neighborCell(i, d);
+        unsigned char &theirs = writableChunk(j).neighborMasks[cellSlot(j)];
+        if (present)
+            theirs |= edgeBit(opposite(d));
+        else
+            theirs &= ~edgeBit(opposite(d));
+    }
+
+    if (present)
+        writableChunk(i).neighborMasks[cellSlot(i)] = mask;
+}
+
+void Board::linkAll() {
+    for (int i = 0; i < cellLimit(); ++i) {
+        if ((*m_chunks)[i >> BoardChunk::SHIFT] == nullptr)
+            i |= BoardChunk::SIZE - 1; // Skip the whole chunk.
+        else if (cell(i) != nullptr)
+            writableChunk(i).neighborMasks[cellSlot(i)] = neighborMask(i);
+    }
+}
+
+// +----------------------------------+
+// + Board connectivity helpers       +
+// +----------------------------------+
+
+bool Board::passable(const int &i) const {
+    const BoardChunk &c = chunk(i);
+    return c.cells[cellSlot(i)] != nullptr &&
+           c.types[cellSlot(i)] != TileType::COLLISION;
+}
+
+unsigned char Board::openMask(const int &i) const {
+    const BoardChunk &c = chunk(i);
+    unsigned char open = c.neighborMasks[cellSlot(i)] &
+                         ~(c.gateMasks[cellSlot(i)] >> ACTIVE_SHIFT);
+
+    for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+        if (!(open & edgeBit(d)))
+            continue;
+        int j = neighborCell(i, d);
+        if (chunk(j).types[cellSlot(j)] == TileType::COLLISION)
+            open &= ~edgeBit(d);
+    }
+
+    return open;
+}
+
+int Board::findComponent(const int &i) {
+    int root = i;
+
+    while (m_components[root] >= 0) {
+        int parent = m_components[root];
+        if (m_components[parent] >= 0)
+            m_components[root] = m_components[parent]; // Path halving
+        root = m_components[root];
+    }
+
+    return root;
+}
+
+void Board::uniteComponents(const int &i, const int &j) {
+    int a = findComponent(i), b = findComponent(j);
+    if (a == b)
+        return;
+
+    // Hang the smaller set below the larger one.
+    if (m_components[a] > m_components[b])
+        std::swap(a, b);
+    m_components[a] += m_components[b];
+    m_components[b] = a;
+}
+
+void Board::openCell(const int &i) {
+    if (!m_componentsValid || !passable(i))
+        return;
+
+    unsigned char open = openMask(i);
+    for (Direction d : {UP, DOWN, LEFT, RIGHT})
+        if (open & edgeBit(d))
+            uniteComponents(i, neighborCell(i, d));
+}
+
+void Board::openEdge(const int &e) {
+    if (!m_componentsValid)
+        return;
+
+    int i = e / 2;
+    int j = neighborCell(i, e % 2 ? UP : RIGHT);
+    if (passable(i) && passable(j))
+        uniteComponents(i, j);
+}
+
+void Board::updateComponents() {
+    if (m_componentsValid)
+        return;
+
+    // Every edge is owned by one cell, so looking right and up from
+    // each cell visits each edge once.
+    constexpr unsigned char FORWARD = 1 << RIGHT | 1 << UP;
+    m_components.assign(cellLimit(), -1);
+
+    for (std::size_t k = 0; k < m_chunks->size(); ++k) {
+        if ((*m_chunks)[k] == nullptr)
+            continue;
+
+        const BoardChunk &c = *(*m_chunks)[k];
+        int first = static_cast<int>(k) << BoardChunk::SHIFT;
+        for (int slot = 0; slot < BoardChunk::SIZE; ++slot) {
+            if (c.cells[slot] == nullptr ||
+                c.types[slot] == TileType::COLLISION)
+                continue;
+
+            unsigned char open = c.neighborMasks[slot] &
+                                 ~(c.gateMasks[slot] >> ACTIVE_SHIFT) &
+                                 FORWARD;
+            for (Direction d : {RIGHT, UP}) {
+                if (!(open & edgeBit(d)))
+                    continue;
+                int j = neighborCell(first + slot, d);
+                if (chunk(j).types[cellSlot(j)] != TileType::COLLISION)
+                    uniteComponents(first + slot, j);
+            }
+        }
+    }
+
+    m_componentsValid = true;
+}
+
+int Board::tileCell(const TilePtr &t) const {
+    if (t == nullptr || !inBounds(t->getX(), t->getY()))
+        return -1;
+
+    int i = cellIndex(t->getX(), t->getY());
+    const TilePtr &here = cell(i);
+    return (here != nullptr && here->getName() == t->getName()) ? i : -1;
+}
+
+int Board::gateEdge(const GatePtr &g) const {
+    if (g == nullptr)
+        return -1;
+
+    auto it = m_gateNamesMap->find(g->getName());
+    if (it == m_gateNamesMap->end() ||
+        !gateTilePairEquals(edge(it->second), g))
+        return -1;
+
+    return it->second;
+}
+
+TileHandle Board::tileHandle(const int &i) const {
+    if (i > TileHandle::MAX_INDEX || cell(i) == nullptr)
+        return TileHandle{};
+
+    return TileHandle{i, chunk(i).tileGenerations[cellSlot(i)]};
+}
+
+GateHandle Board::gateHandle(const int &e) const {
+    if (e > GateHandle::MAX_INDEX || edge(e) == nullptr)
+        return GateHandle{};
+
+    return GateHandle{e, chunk(e / 2).gateGenerations[edgeSlot(e)]};
+}
+
+int Board::handleCell(const TileHandle &h) const {
+    int i = h.index();
+    if (h.isNull() || i >= cellLimit() || cell(i) == nullptr ||
+        (chunk(i).tileGenerations[cellSlot(i)] &
+         TileHandle::GENERATION_MASK) != h.generation())
+        return -1;
+
+    return i;
+}
+
+int Board::handleEdge(const GateHandle &h) const {
+    int e = h.index();
+    if (h.isNull() || e >= 2 * cellLimit() || edge(e) == nullptr ||
+        (chunk(e / 2).gateGenerations[edgeSlot(e)] &
+         GateHandle::GENERATION_MASK) != h.generation())
+        return -1;
+
+    return e;
+}
+
+void Board::updateGateMasks(const int &e) {
+    int i = e / 2;
+    bool vertical = e % 2;
+    int j = vertical ? cellIndex(cellX(i), cellY(i) + 1)
+                     : cellIndex(cellX(i) + 1, cellY(i));
+    Direction toward = vertical ? UP : RIGHT;
+    Direction back = vertical ? DOWN : LEFT;
+
+    const GatePtr &g = edge(e);
+    unsigned char here = edgeBit(toward), there = edgeBit(back);
+    unsigned char &maskI = writableChunk(i).gateMasks[cellSlot(i)];
+    unsigned char &maskJ = writableChunk(j).gateMasks[cellSlot(j)];
+    maskI &= ~(here | (here << ACTIVE_SHIFT));
+    maskJ &= ~(there | (there << ACTIVE_SHIFT));
+
+    if (g == nullptr)
+        return;
+
+    if (g->isActive()) {
+        here |= here << ACTIVE_SHIFT;
+        there |= there << ACTIVE_SHIFT;
+    }
+    maskI |= here;
+    maskJ |= there;
+}
+
+std::uint64_t Board::tileKey(const int &i) const {
+    const TilePtr &t = cell(i);
+    if (t == nullptr)
+        return 0;
+
+    std::uint64_t feature = (std::uint64_t{t->getColorID()} << 8) |
+                            static_cast<std::uint64_t>(t->getTileType());
+    return mix64(mix64(ZOBRIST_TILE, i), feature);
+}
+
+std::uint64_t Board::gateKey(const int &e) const {
+    const GatePtr &g = edge(e);
+    if (g == nullptr)
+        return 0;
+
+    return mix64(mix64(ZOBRIST_GATE, e), g->isActive());
+}
+
+std::uint64_t Board::cursorKey() const {
+    std::uint64_t x = static_cast<std::uint32_t>(m_cursor.getX());
+    std::uint64_t y = static_cast<std::uint32_t>(m_cursor.getY());
+    return mix64(ZOBRIST_CURSOR, (y << 32) | x);
+}
+
+void Board::rehash() {
+    m_hash = cursorKey();
+
+    for (std::size_t k = 0; k < m_chunks->size(); ++k) {
+        if ((*m_chunks)[k] == nullptr)
+            continue;
+
+        int i = static_cast<int>(k) << BoardChunk::SHIFT;
+        for (int j = i; j < i + BoardChunk::SIZE; ++j)
+            m_hash ^= tileKey(j);
+        for (int e = 2 * i; e < 2 * (i + BoardChunk::SIZE); ++e)
+            m_hash ^= gateKey(e);
+    }
+}
+
+void Board::bucketTile(const int &i) {
+    const TilePtr &t = cell(i);
+    if (t == nullptr || !t->isDirection())
+        return;
+
+    ColorID color = t->getColorID();
+    ColorBuckets &buckets = unshare(m_colorBuckets);
+    if (color >= buckets.size())
+        buckets.resize(color + 1);
+
+    writableChunk(i).bucketSlots[cellSlot(i)] =
+        static_cast<int>(buckets[color].size());
+    buckets[color].push_back(i);
+}
+
+void Board::unbucketTile(const int &i) {
+    int slot = chunk(i).bucketSlots[cellSlot(i)];
+    if (slot < 0)
+        return;
+
+    // Swap the last cell of the bucket into the freed slot.
+    std::vector<int> &bucket =
+        unshare(m_colorBuckets)[cell(i)->getColorID()];
+    int last = bucket.back();
+    bucket[slot] = last;
+    writableChunk(last).bucketSlots[cellSlot(last)] = slot;
+    bucket.pop_back();
+    writableChunk(i).bucketSlots[cellSlot(i)] = -1;
+}
+
+void Board::placeCursor(const int &x, const int &y) {
+    int cursorX = m_cursor.getX(), cursorY = m_cursor.getY();
+    if (inBounds(cursorX, cursorY)) {
+        int i = cellIndex(cursorX, cursorY);
+        touchCell(i, BoardChangeRecord::CURSOR);
+        if (cell(i) != nullptr)
+            writableTile(i)->setCursor(false);
+    }
+
+    m_hash ^= cursorKey();
+    m_cursor.setX(x);
+    m_cursor.setY(y);
+    m_hash ^= cursorKey();
+
+    if (inBounds(x, y)) {
+        int i = cellIndex(x, y);
+        touchCell(i, BoardChangeRecord::CURSOR);
+        if (cell(i) != nullptr)
+            writableTile(i)->setCursor(true);
+    }
+}
+
+void Board::rotateBucket(const ColorID &color, const Rotation &r) {
+    for (int i : (*m_colorBuckets)[color]) {
+        m_hash ^= tileKey(i);
+        setCellType(i, rotateType(cell(i)->getTileType(), r));
+        m_hash ^= tileKey(i);
+    }
+}
+
+void Board::recolorTile(const int &i, const ColorID &color) {
+    unbucketTile(i);
+    m_hash ^= tileKey(i);
+    writableTile(i)->setColorID(color);
+    touchCell(i, BoardChangeRecord::TILE);
+    m_hash ^= tileKey(i);
+    bucketTile(i);
+}
+
+void Board::retypeTile(const int &i, const TileType &type) {
+    unbucketTile(i);
+    m_hash ^= tileKey(i);
+    setCellType(i, type);
+    m_hash ^= tileKey(i);
+    bucketTile(i);
+}
+
+void Board::setCellType(const int &i, const TileType &type) {
+    bool wasPassable = passable(i);
+    writableTile(i)->setTileType(type);
+    writableChunk(i).types[cellSlot(i)] = type;
+    touchCell(i, BoardChangeRecord::TILE);
+
+    // A tile that turns into a collision tile may split its component.
+    if (wasPassable && !passable(i))
+        m_componentsValid = false;
+    else if (!wasPassable)
+        openCell(i);
+}
+
+// +----------------------------------+
+// + Board journal helpers            +
+// +----------------------------------+
+
+void Board::record(BoardDelta delta) {
+    if (m_replaying || m_journalCapacity == 0)
+        return;
+
+    // A new change makes the undone ones unreachable.
+    for (std::size_t k = m_journalPos; k < m_journalEnd; ++k)
+        m_journal[(m_journalHead + k) % m_journalCapacity] = BoardDelta{};
+    m_journalEnd = m_journalPos;
+
+    std::size_t slot = (m_journalHead + m_journalEnd) % m_journalCapacity;
+    if (m_journalEnd == m_journalCapacity) {
+        // Full: overwrite the oldest entry.
+        m_journalHead = (m_journalHead + 1) % m_journalCapacity;
+        --m_journalEnd;
+    }
+
+    if (slot == m_journal.size())
+        m_journal.push_back(std::move(delta));
+    else
+        m_journal[slot] = std::move(delta);
+    m_journalPos = ++m_journalEnd;
+}
+
+void Board::restore(const TilePtr &t, const std::uint32_t &owner) {
+    add(t);
+
+    // The board still owns the tile unless a snapshot was taken since.
+    if (owner == m_epoch) {
+        int i = cellIndex(t->getX(), t->getY());
+        writableChunk(i).tileOwners[cellSlot(i)] = m_epoch;
+    }
+}
+
+void Board::restore(const GatePtr &g, const std::uint32_t &owner) {
+    add(g);
+
+    if (owner == m_epoch) {
+        int e = gateEdge(g);
+        writableChunk(e / 2).gateOwners[edgeSlot(e)] = m_epoch;
+    }
+}
+
+void Board::replay(const BoardDelta &delta, bool inverse) {
+    // The Board functions below must not journal the replay itself.
+    m_replaying = true;
+    try {
+        switch (delta.change) {
+        case BoardChange::MOVE_CURSOR:
+            if (inverse)
+                placeCursor(delta.a, delta.b);
+            else
+                moveCursor(static_cast<Direction>(delta.arg));
+            break;
+        case BoardChange::SET_CURSOR:
+            if (inverse)
+                placeCursor(delta.a, delta.b);
+            else
+                setCursorTile(delta.tile);
+            break;
+        case BoardChange::ROTATE_TILE:
+            rotateTile(cell(delta.a), replayRotation(delta.arg, inverse));
+            break;
+        case BoardChange::ROTATE_TILES:
+            rotateBucket(static_cast<ColorID>(delta.a),
+                         replayRotation(delta.arg, inverse));
+            break;
+        case BoardChange::ADD_TILE:
+        case BoardChange::REMOVE_TILE:
+            if (inverse == (delta.change == BoardChange::ADD_TILE))
+                remove(delta.tile);
+            else
+                restore(delta.tile, static_cast<std::uint32_t>(delta.a));
+            break;
+        case BoardChange::ADD_GATE:
+        case BoardChange::REMOVE_GATE:
+            if (inverse == (delta.change == BoardChange::ADD_GATE))
+                remove(delta.gate);
+            else
+                restore(delta.gate, static_cast<std::uint32_t>(delta.a));
+            break;
+        case BoardChange::SET_GATE_ACTIVE:
+            setGateActive(delta.gate, inverse ? delta.a : delta.arg);
+            break;
+        case BoardChange::SET_TILE_COLOR:
+            recolorTile(cellIndex(delta.tile->getX(), delta.tile->getY()),
+                        static_cast<ColorID>(inverse ? delta.a : delta.b));
+            break;
+        case BoardChange::SET_TILE_TYPE:
+            retypeTile(cellIndex(delta.tile->getX(), delta.tile->getY()),
+                       static_cast<TileType>(inverse ? delta.a : delta.b));
+            break;
+        case BoardChange::NONE:
+            break;
+        }
+    } catch (...) {
+        m_replaying = false;
+        throw;
+    }
+    m_replaying = false;
+}
 
 // +----------------------------------+
 // + Board getters/setters            +
@@ -37,7 +961,13 @@ int Board::getLength() const {
 }
 
 void Board::setLength(const int &length) {
-    m_length = length;
+    if (length < 0) {
+        ErrorMessage INVAL_L{name::PONE_GLOBAL_NAME, name::BOARD_SETL,
+                             std::format("Invalid length {}.", length)};
+        throw InvalidValueException(INVAL_L);
+    }
+
+    resize(length, m_width);
 }
 
 std::string Board::getName() const {
@@ -53,39 +983,41 @@ int Board::getWidth() const {
 }
 
 void Board::setWidth(const int &width) {
-    m_width = width;
+    if (width < 0) {
+        ErrorMessage INVAL_W{name::PONE_GLOBAL_NAME, name::BOARD_SETW,
+                             std::format("Invalid width {}.", width)};
+        throw InvalidValueException(INVAL_W);
+    }
+
+    resize(m_length, width);
 }
 
 TilePtr Board::getCursorTile() const {
-    return m_cursor.getTile();
+    return getTile(m_cursor.getX(), m_cursor.getY());
 }
 
 void Board::setCursorTile(const TilePtr &t) {
-    m_cursor.setTile(t);
+    if (t == nullptr)
+        return;
+
+    record({BoardChange::SET_CURSOR, 0, m_cursor.getX(), m_cursor.getY(), t,
+            nullptr});
+    placeCursor(t->getX(), t->getY());
 }
 
 TilePtr Board::getTile(const std::string &name) const {
-    TilePtr t;
+    auto it = m_tileNamesMap->find(name);
+    if (it == m_tileNamesMap->end())
+        return nullptr;
 
-    try {
-        t = m_tileNamesMap.at(name);
-    } catch (const std::out_of_range &e) {
-        t = nullptr;
-    }
-
-    return t;
+    return cell(it->second);
 }
 
 TilePtr Board::getTile(const int &x, const int &y) const {
-    TilePtr t;
+    if (!inBounds(x, y))
+        return nullptr;
 
-    try {
-        t = m_tileCoordPairsMap.at(CoordPair{x, y});
-    } catch (const std::out_of_range &e) {
-        t = nullptr;
-    }
-
-    return t;
+    return cell(cellIndex(x, y));
 }
 
 TilePtr Board::getTile(const TilePtr &t, const Direction &direction) const {
@@ -94,36 +1026,31 @@ TilePtr Board::getTile(const TilePtr &t, const Direction &direction) const {
                                "Tile is null."};
 
         throw InvalidTileException(TILE_NULL);
-    }
-
-    int tileX = t->getX(), tileY = t->getY();
-
-    switch (direction) {
-    case UP:
-        return getTile(tileX, tileY + 1);
-    case DOWN:
-        return getTile(tileX, tileY - 1);
-    case LEFT:
-        return getTile(tileX + 1, tileY);
-    case RIGHT:
-        return getTile(tileX - 1, tileY);
-    default:
+    } else if (!validDirection(direction)) {
         ErrorMessage INVAL_DIR{name::PONE_GLOBAL_NAME, name::BOARD_GETT3,
                                "Invalid direction."};
         throw InvalidDirectionException(INVAL_DIR);
     }
+
+    int x = t->getX(), y = t->getY();
+    if (inBounds(x, y)) {
+        int i = cellIndex(x, y);
+        const BoardChunk &c = chunk(i);
+        if (c.cells[cellSlot(i)] != nullptr)
+            return (c.neighborMasks[cellSlot(i)] & edgeBit(direction))
+                       ? cell(neighborCell(i, direction))
+                       : nullptr;
+    }
+
+    return getTile(x + directionDX(direction), y + directionDY(direction));
 }
 
 GatePtr Board::getGate(const std::string &name) const {
-    GatePtr target;
-
-    try {
-        target = m_gateNamesMap.at(name);
-    } catch (const std::out_of_range &e) {
-        target = nullptr;
-    }
+    auto it = m_gateNamesMap->find(name);
+    if (it == m_gateNamesMap->end())
+        return nullptr;
 
-    return target;
+    return edge(it->second);
 }
 
 GatePtr Board::getGate(const TilePtr &t1, const TilePtr &t2) const {
@@ -137,16 +1064,11 @@ GatePtr Board::getGate(const TilePtr &t1, const TilePtr &t2) const {
         throw InvalidTileException(T2_NULL);
     }
 
-    GatePtr g;
+    int e = edgeIndex(t1->getX(), t1->getY(), t2->getX(), t2->getY());
+    if (e < 0)
+        return nullptr;
 
-    try {
-        TilePair tp{t1, t2};
-        g = m_gateTilePairsMap.at(tp);
-    } catch (const std::out_of_range &) {
-        g = nullptr;
-    }
-
-    return g;
+    return edge(e);
 }
 
 GatePtr Board::getGate(const TilePtr &t, const Direction &d) const {
@@ -155,26 +1077,21 @@ GatePtr Board::getGate(const TilePtr &t, const Direction &d) const {
                             "Tile is null."};
 
         throw InvalidTileException(T_NULL);
-    }
-
-    TilePtr currentTile = m_cursor.getTile();
-
-    switch (d) {
-    case UP:
-        return getGate(currentTile, getTile(currentTile, UP));
-    case DOWN:
-        return getGate(currentTile, getTile(currentTile, DOWN));
-    case LEFT:
-        return getGate(currentTile, getTile(currentTile, LEFT));
-    case RIGHT:
-        return getGate(currentTile, getTile(currentTile, RIGHT));
-    default:
+    } else if (!validDirection(d)) {
         ErrorMessage INVAL_DIR{name::PONE_GLOBAL_NAME, name::BOARD_GETG3,
                                "Invalid direction."};
         throw InvalidDirectionException(INVAL_DIR);
     }
 
-    return nullptr;
+    int x = t->getX(), y = t->getY();
+    if (!inBounds(x, y))
+        return nullptr; // Every edge of an outside cell is off the board.
+
+    int i = cellIndex(x, y);
+    if (!(chunk(i).gateMasks[cellSlot(i)] & edgeBit(d)))
+        return nullptr;
+
+    return edge(cellEdge(i, d));
 }
 
 // +----------------------------------+
@@ -198,11 +1115,45 @@ bool Board::gateNameEquals(const GatePtr &g1, const GatePtr &g2) const {
 }
 
 void Board::add(const TilePtr &t) {
-    m_tileNamesTree.insert(t);
-    m_tileNamesMap[t->getName()] = t;
+    if (t == nullptr) {
+        ErrorMessage T_NULL{name::PONE_GLOBAL_NAME, name::BOARD_ADD1,
+                            "Tile is null."};
+        throw InvalidTileException(T_NULL);
+    }
+
+    int x = t->getX(), y = t->getY();
+
+    if (!inBounds(x, y)) {
+        ErrorMessage T_OOB{
+            name::PONE_GLOBAL_NAME, name::BOARD_ADD1,
+            std::format("Tile \"{}\" at ({}, {}) is outside of the board.",
+                        t->getName(), x, y)};
+        throw InvalidTileException(T_OOB);
+    }
 
-    m_tileCoordPairsTree.insert(t);
-    m_tileCoordPairsMap[t->getCoordPair()] = t;
+    int i = cellIndex(x, y);
+
+    if (cell(i) != nullptr || m_tileNamesMap->contains(t->getName())) {
+        ErrorMessage T_DUP{
+            name::PONE_GLOBAL_NAME, name::BOARD_ADD1,
+            std::format("Tile \"{}\" at ({}, {}) already exists.",
+                        t->getName(), x, y)};
+        throw DuplicateTilesException(T_DUP);
+    }
+
+    // A replayed tile may be in a snapshot too, so leave it unowned.
+    record({BoardChange::ADD_TILE, 0, static_cast<int>(m_epoch), 0, t,
+            nullptr});
+    BoardChunk &c = writableChunk(i);
+    c.cells[cellSlot(i)] = t;
+    c.types[cellSlot(i)] = t->getTileType();
+    c.tileOwners[cellSlot(i)] = m_replaying ? 0 : m_epoch;
+    unshare(m_tileNamesMap)[t->getName()] = i;
+    linkCell(i, true);
+    bucketTile(i);
+    m_hash ^= tileKey(i);
+    touchCell(i, BoardChangeRecord::TILE);
+    openCell(i);
     ++m_numTiles;
 }
 
@@ -213,26 +1164,82 @@ void Board::remove(const TilePtr &t) {
         throw InvalidTileException(T_NULL);
     }
 
-    try {
-        m_tileNamesTree.remove(t);
-        m_tileNamesMap.erase(t->getName());
+    auto it = m_tileNamesMap->find(t->getName());
 
-        m_tileCoordPairsTree.remove(t);
-        m_tileCoordPairsMap.erase(t->getCoordPair());
-    } catch (const std::out_of_range &e) {
+    if (it == m_tileNamesMap->end() || !tileCoordEquals(cell(it->second), t)) {
         ErrorMessage T_NF{
             name::PONE_GLOBAL_NAME, name::BOARD_REM1,
             std::format("Tile \"{}\" was not found.", t->getName())};
         throw InvalidTileException(T_NF);
     }
+
+    int i = it->second; // removeCell erases the entry.
+    removeCell(i);
+}
+
+void Board::removeCell(const int &i) {
+    record({BoardChange::REMOVE_TILE, 0,
+            static_cast<int>(chunk(i).tileOwners[cellSlot(i)]), 0, cell(i),
+            nullptr});
+    unbucketTile(i);
+    m_hash ^= tileKey(i);
+    unshare(m_tileNamesMap).erase(cell(i)->getName());
+    if (passable(i))
+        m_componentsValid = false;
+
+    BoardChunk &c = writableChunk(i);
+    c.cells[cellSlot(i)] = nullptr;
+    c.tileOwners[cellSlot(i)] = 0;
+    ++c.tileGenerations[cellSlot(i)];
+    linkCell(i, false);
+    touchCell(i, BoardChangeRecord::TILE);
+    --m_numTiles;
 }
 
 void Board::add(const GatePtr &g) {
-    m_gateNamesTree.insert(g);
-    m_gateNamesMap[g->getName()] = g;
+    if (g == nullptr) {
+        ErrorMessage G_NULL{name::PONE_GLOBAL_NAME, name::BOARD_ADD2,
+                            "Gate is null."};
+        throw InvalidGateException(G_NULL);
+    }
+
+    const TilePtr &t1 = g->getTile1(), &t2 = g->getTile2();
+    int e = (t1 == nullptr || t2 == nullptr)
+                ? -1
+                : edgeIndex(t1->getX(), t1->getY(), t2->getX(), t2->getY());
+
+    if (e < 0) {
+        ErrorMessage G_INVAL{
+            name::PONE_GLOBAL_NAME, name::BOARD_ADD2,
+            std::format("Gate \"{}\" is not between two adjacent tiles.",
+                        g->getName())};
+        throw InvalidGateException(G_INVAL);
+    } else if (cell(cellIndex(t1->getX(), t1->getY())) == nullptr ||
+               cell(cellIndex(t2->getX(), t2->getY())) == nullptr) {
+        ErrorMessage G_EMPTY{
+            name::PONE_GLOBAL_NAME, name::BOARD_ADD2,
+            std::format("Gate \"{}\" leads to an empty cell.",
+                        g->getName())};
+        throw InvalidGateException(G_EMPTY);
+    } else if (edge(e) != nullptr || m_gateNamesMap->contains(g->getName())) {
+        ErrorMessage G_DUP{
+            name::PONE_GLOBAL_NAME, name::BOARD_ADD2,
+            std::format("Gate \"{}\" already exists.", g->getName())};
+        throw DuplicateGatesException(G_DUP);
+    }
 
-    m_gateTilePairsTree.insert(g);
-    m_gateTilePairsMap[g->getTilePair()] = g;
+    record({BoardChange::ADD_GATE, 0, static_cast<int>(m_epoch), 0, nullptr,
+            g});
+    BoardChunk &c = writableChunk(e / 2);
+    c.gateEdges[edgeSlot(e)] = g;
+    c.gateOwners[edgeSlot(e)] = m_replaying ? 0 : m_epoch;
+    unshare(m_gateNamesMap)[g->getName()] = e;
+    updateGateMasks(e);
+    m_hash ^= gateKey(e);
+    touchEdge(e);
+    if (g->isActive())
+        m_componentsValid = false;
+    ++m_numGates;
 }
 
 void Board::remove(const GatePtr &g) {
@@ -242,18 +1249,239 @@ void Board::remove(const GatePtr &g) {
         throw InvalidGateException(G_NULL);
     }
 
-    try {
-        m_gateNamesTree.remove(g);
-        m_gateNamesMap.erase(g->getName());
+    int e = gateEdge(g);
 
-        m_gateTilePairsTree.remove(g);
-        m_gateTilePairsMap.erase(g->getTilePair());
-    } catch (const std::out_of_range &e) {
+    if (e < 0) {
         ErrorMessage G_NF{
             name::PONE_GLOBAL_NAME, name::BOARD_REM2,
             std::format("Gate \"{}\" was not found.", g->getName())};
         throw InvalidGateException(G_NF);
     }
+
+    removeEdge(e);
+}
+
+void Board::removeEdge(const int &e) {
+    record({BoardChange::REMOVE_GATE, 0,
+            static_cast<int>(chunk(e / 2).gateOwners[edgeSlot(e)]), 0, nullptr,
+            edge(e)});
+    m_hash ^= gateKey(e);
+    unshare(m_gateNamesMap).erase(edge(e)->getName());
+    bool wasActive = edge(e)->isActive();
+
+    BoardChunk &c = writableChunk(e / 2);
+    c.gateEdges[edgeSlot(e)] = nullptr;
+    c.gateOwners[edgeSlot(e)] = 0;
+    ++c.gateGenerations[edgeSlot(e)];
+    updateGateMasks(e);
+    touchEdge(e);
+    if (wasActive)
+        openEdge(e);
+    --m_numGates;
+}
+
+void Board::assign(std::vector<Tile> tiles, std::vector<Gate> gates) {
+    auto chunks = std::make_shared<ChunkTable>(m_chunks->size());
+    std::uint32_t generation = m_generation + 1;
+    auto allocate = [&](const std::size_t &k) -> BoardChunk & {
+        std::shared_ptr<BoardChunk> &c = (*chunks)[k];
+        if (c == nullptr)
+            c = std::make_shared<BoardChunk>(generation);
+        return *c;
+    };
+
+    // Build everything aside first, so that the board is left as it
+    // was if the input is invalid.
+    auto tileNames = std::make_shared<NameIndex>();
+    tileNames->reserve(tiles.size());
+    auto tileBlock = std::make_shared<std::vector<Tile>>(std::move(tiles));
+
+    for (Tile &t : *tileBlock) {
+        int x = t.getX(), y = t.getY();
+
+        if (!inBounds(x, y)) {
+            ErrorMessage T_OOB{
+                name::PONE_GLOBAL_NAME, name::BOARD_ASSIGN,
+                std::format("Tile \"{}\" at ({}, {}) is outside of the board.",
+                            t.getName(), x, y)};
+            throw InvalidTileException(T_OOB);
+        }
+
+        int i = cellIndex(x, y);
+        BoardChunk &c = allocate(i >> BoardChunk::SHIFT);
+
+        if (c.cells[cellSlot(i)] != nullptr ||
+            !tileNames->emplace(t.getName(), i).second) {
+            ErrorMessage T_DUP{
+                name::PONE_GLOBAL_NAME, name::BOARD_ASSIGN,
+                std::format("Tile \"{}\" at ({}, {}) already exists.",
+                            t.getName(), x, y)};
+            throw DuplicateTilesException(T_DUP);
+        }
+
+        c.cells[cellSlot(i)] = TilePtr{tileBlock, &t};
+        c.types[cellSlot(i)] = t.getTileType();
+        c.tileOwners[cellSlot(i)] = m_epoch;
+    }
+
+    auto gateNames = std::make_shared<NameIndex>();
+    gateNames->reserve(gates.size());
+    auto gateBlock = std::make_shared<std::vector<Gate>>(std::move(gates));
+
+    for (Gate &g : *gateBlock) {
+        TilePtr t1 = g.getTile1(), t2 = g.getTile2();
+        int e = (t1 == nullptr || t2 == nullptr)
+                    ? -1
+                    : edgeIndex(t1->getX(), t1->getY(), t2->getX(), t2->getY());
+
+        if (e < 0) {
+            ErrorMessage G_INVAL{
+                name::PONE_GLOBAL_NAME, name::BOARD_ASSIGN,
+                std::format("Gate \"{}\" is not between two adjacent tiles.",
+                            g.getName())};
+            throw InvalidGateException(G_INVAL);
+        }
+
+        // The gate's tiles belong to the caller: bind it to the tiles
+        // now in the cells instead.
+        auto placed = [&](const TilePtr &t) -> TilePtr {
+            int i = cellIndex(t->getX(), t->getY());
+            const std::shared_ptr<BoardChunk> &k =
+                (*chunks)[i >> BoardChunk::SHIFT];
+            return k == nullptr ? nullptr : k->cells[cellSlot(i)];
+        };
+        TilePtr p1 = placed(t1), p2 = placed(t2);
+
+        if (p1 == nullptr || p2 == nullptr) {
+            ErrorMessage G_EMPTY{
+                name::PONE_GLOBAL_NAME, name::BOARD_ASSIGN,
+                std::format("Gate \"{}\" leads to an empty cell.",
+                            g.getName())};
+            throw InvalidGateException(G_EMPTY);
+        }
+        g.setTilePair({std::move(p1), std::move(p2)});
+
+        BoardChunk &c = allocate(e >> (BoardChunk::SHIFT + 1));
+
+        if (c.gateEdges[edgeSlot(e)] != nullptr ||
+            !gateNames->emplace(g.getName(), e).second) {
+            ErrorMessage G_DUP{
+                name::PONE_GLOBAL_NAME, name::BOARD_ASSIGN,
+                std::format("Gate \"{}\" already exists.", g.getName())};
+            throw DuplicateGatesException(G_DUP);
+        }
+
+        c.gateEdges[edgeSlot(e)] = GatePtr{gateBlock, &g};
+        c.gateOwners[edgeSlot(e)] = m_epoch;
+    }
+
+    m_chunks = std::move(chunks);
+    m_generation = generation;
+    m_tileNamesMap = std::move(tileNames);
+    m_gateNamesMap = std::move(gateNames);
+    m_colorBuckets = std::make_shared<ColorBuckets>();
+    m_numTiles = static_cast<int>(tileBlock->size());
+    m_numGates = static_cast<int>(gateBlock->size());
+
+    for (int i = 0; i < cellLimit(); ++i) {
+        if ((*m_chunks)[i >> BoardChunk::SHIFT] == nullptr)
+            i |= BoardChunk::SIZE - 1;
+        else
+            bucketTile(i);
+    }
+    for (const auto &[name, e] : *m_gateNamesMap)
+        updateGateMasks(e);
+    linkAll();
+
+    for (std::size_t k = 0; k < m_chunks->size(); ++k)
+        markDirty(k);
+    resetChanges();
+    m_componentsValid = false;
+
+    rehash();
+    clearJournal();
+}
+
+void Board::setGateActive(const GatePtr &g, bool active) {
+    int e = gateEdge(g);
+
+    if (e < 0) {
+        ErrorMessage G_NF{name::PONE_GLOBAL_NAME, name::BOARD_SETGACTIVE,
+                          "Gate is not on the board."};
+        throw InvalidGateException(G_NF);
+    }
+
+    setEdgeActive(e, active);
+}
+
+void Board::setEdgeActive(const int &e, bool active) {
+    const GatePtr &gate = writableGate(e);
+    bool wasActive = gate->isActive();
+    record({BoardChange::SET_GATE_ACTIVE, active, wasActive, 0, nullptr,
+            gate});
+    m_hash ^= gateKey(e);
+    if (active)
+        gate->setActive();
+    else
+        gate->setInactive();
+    m_hash ^= gateKey(e);
+
+    updateGateMasks(e);
+    touchEdge(e);
+    if (!active)
+        openEdge(e);
+    else if (!wasActive)
+        m_componentsValid = false;
+}
+
+void Board::toggleGate(const GatePtr &g) {
+    if (g == nullptr) {
+        ErrorMessage G_NULL{name::PONE_GLOBAL_NAME, name::BOARD_TOGGLEG,
+                            "Gate is null."};
+        throw InvalidGateException(G_NULL);
+    }
+
+    int e = gateEdge(g);
+
+    if (e < 0) {
+        ErrorMessage G_NF{name::PONE_GLOBAL_NAME, name::BOARD_TOGGLEG,
+                          "Gate is not on the board."};
+        throw InvalidGateException(G_NF);
+    }
+
+    setEdgeActive(e, !edge(e)->isActive());
+}
+
+void Board::setTileColor(const TilePtr &t, const std::string &color) {
+    int i = tileCell(t);
+
+    if (i < 0) {
+        ErrorMessage T_NF{name::PONE_GLOBAL_NAME, name::BOARD_SETTCLR,
+                          "Tile is not on the board."};
+        throw InvalidTileException(T_NF);
+    }
+
+    ColorID id = ColorRegistry::intern(color);
+    record({BoardChange::SET_TILE_COLOR, 0,
+            static_cast<int>(cell(i)->getColorID()), static_cast<int>(id),
+            cell(i), nullptr});
+    recolorTile(i, id);
+}
+
+void Board::setTileType(const TilePtr &t, const std::string &type) {
+    int i = tileCell(t);
+
+    if (i < 0) {
+        ErrorMessage T_NF{name::PONE_GLOBAL_NAME, name::BOARD_SETTTYPE,
+                          "Tile is not on the board."};
+        throw InvalidTileException(T_NF);
+    }
+
+    TileType newType = tileTypeFromName(type);
+    record({BoardChange::SET_TILE_TYPE, 0,
+            static_cast<int>(cell(i)->getTileType()),
+            static_cast<int>(newType), cell(i), nullptr});
+    retypeTile(i, newType);
 }
 
 void Board::load(const std::string &filename) {
@@ -270,48 +1498,61 @@ void Board::save(const std::string &filename) {
 // +----------------------------------+
 
 void Board::moveCursor(const Direction &d) {
-    TilePtr prevTile = m_cursor.getTile();
-    prevTile->setCursor(false);
-
-    int cursorX = m_cursor.getX(), cursorY = m_cursor.getY();
-
-    switch (d) {
-    case UP:
-        m_cursor.setY(cursorY + 1);
-        break;
-    case DOWN:
-        m_cursor.setY(cursorY - 1);
-        break;
-    case LEFT:
-        m_cursor.setX(cursorX - 1);
-        break;
-    case RIGHT:
-        m_cursor.setX(cursorX + 1);
-        break;
-    default:
+    if (!validDirection(d)) {
         ErrorMessage INVAL_DIR{name::PONE_GLOBAL_NAME, name::BOARD_MVCSR,
                                "Invalid direction."};
         throw InvalidDirectionException(INVAL_DIR);
     }
 
-    m_cursor.setTile(getTile(prevTile, d));
-    m_cursor.getTile()->setCursor(true);
+    int cursorX = m_cursor.getX() + directionDX(d);
+    int cursorY = m_cursor.getY() + directionDY(d);
+
+    if (!inBounds(cursorX, cursorY) ||
+        cell(cellIndex(cursorX, cursorY)) == nullptr) {
+        ErrorMessage T_NF{name::PONE_GLOBAL_NAME, name::BOARD_MVCSR,
+                          std::format("No tile at ({}, {}).", cursorX,
+                                      cursorY)};
+        throw InvalidTileException(T_NF);
+    }
+
+    record({BoardChange::MOVE_CURSOR, static_cast<unsigned char>(d),
+            m_cursor.getX(), m_cursor.getY(), nullptr, nullptr});
+    placeCursor(cursorX, cursorY);
 }
 
-bool Board::checkMove(const Direction &d) {
+bool Board::checkMove(const Direction &d) const {
     // Check collision first
 
-    TilePtr curr = m_cursor.getTile();
-    TilePtr target = getTile(curr, d);
-    if (target->isCollision())
+    int x = m_cursor.getX(), y = m_cursor.getY();
+    int targetX = x + directionDX(d), targetY = y + directionDY(d);
+
+    if (!validDirection(d) || !inBounds(x, y) ||
+        !inBounds(targetX, targetY))
+        return false;
+
+    int i = cellIndex(x, y), j = cellIndex(targetX, targetY);
+    const BoardChunk &target = chunk(j);
+    if (target.cells[cellSlot(j)] == nullptr ||
+        target.types[cellSlot(j)] == TileType::COLLISION)
         return false;
-    else if (getGate(curr, target)) {
+    else if (chunk(i).gateMasks[cellSlot(i)] & (edgeBit(d) << ACTIVE_SHIFT)) {
         return false;
     }
 
     return true;
 }
 
+bool Board::tryMoveCursor(const Direction &d) {
+    if (!checkMove(d))
+        return false;
+
+    int x = m_cursor.getX(), y = m_cursor.getY();
+    record({BoardChange::MOVE_CURSOR, static_cast<unsigned char>(d), x, y,
+            nullptr, nullptr});
+    placeCursor(x + directionDX(d), y + directionDY(d));
+    return true;
+}
+
 void Board::rotateTile(const TilePtr &t, const Rotation &r) {
     // ! - DO NOT rotate non-directional tiles!!!
 
@@ -319,6 +1560,15 @@ void Board::rotateTile(const TilePtr &t, const Rotation &r) {
         ErrorMessage T_NULL{name::PONE_GLOBAL_NAME, name::BOARD_ROTT,
                             "Tile is null."};
         throw InvalidTileException(T_NULL);
+    }
+
+    // Tiles on this board are rotated in its own copy and take part
+    // in its hash. Others are rotated as they are.
+    int i = tileCell(t);
+
+    if (i >= 0) {
+        rotateCell(i, r);
+        return;
     } else if (!t->isDirection()) {
         ErrorMessage T_ND{name::PONE_GLOBAL_NAME, name::BOARD_ROTT,
                           std::format("Tile \"{}\" is not a directional tile.",
@@ -326,25 +1576,419 @@ void Board::rotateTile(const TilePtr &t, const Rotation &r) {
         throw InvalidDirectionException(T_ND);
     }
 
-    std::string dir = t->getType();
+    t->setTileType(rotateType(t->getTileType(), r));
+}
 
-    if (r == CLOCKWISE)
-        dir = clockwiseMap.at(dir);
-    else if (r == COUNTER_CLOCKWISE)
-        dir = counterClockwiseMap.at(dir);
+void Board::rotateCell(const int &i, const Rotation &r) {
+    if (!cell(i)->isDirection()) {
+        ErrorMessage T_ND{name::PONE_GLOBAL_NAME, name::BOARD_ROTT,
+                          std::format("Tile \"{}\" is not a directional tile.",
+                                      cell(i)->getName())};
+        throw InvalidDirectionException(T_ND);
+    }
 
-    t->setType(dir);
+    record({BoardChange::ROTATE_TILE, static_cast<unsigned char>(r), i, 0,
+            nullptr, nullptr});
+    m_hash ^= tileKey(i);
+    setCellType(i, rotateType(cell(i)->getTileType(), r));
+    m_hash ^= tileKey(i);
 }
 
 void Board::rotateTiles(const std::string &color, const Rotation &r) {
-    for (TilePtr &t : m_tileNamesTree.inorder()) {
-        if (t->getColor() == color)
-            rotateTile(t, r);
+    ColorID id;
+    if (ColorRegistry::find(color, id))
+        rotateTiles(id, r); // Otherwise no tile on the board has this color.
+}
+
+void Board::rotateTiles(const ColorID &id, const Rotation &r) {
+    if (id == NO_COLOR || id >= m_colorBuckets->size())
+        return;
+
+    record({BoardChange::ROTATE_TILES, static_cast<unsigned char>(r),
+            static_cast<int>(id), 0, nullptr, nullptr});
+    rotateBucket(id, r);
+}
+
+std::vector<CommandResult> Board::apply(std::span<const Command> commands) {
+    std::vector<CommandResult> results(commands.size(), CommandResult::OK);
+
+    for (std::size_t k = 0; k < commands.size(); ++k) {
+        const Command &c = commands[k];
+
+        switch (c.type) {
+        case CommandType::MOVE_CURSOR: {
+            // Walk the whole run of moves on the grid first, and only
+            // place the cursor where it ends up.
+            int x = m_cursor.getX(), y = m_cursor.getY();
+            int toX = x, toY = y;
+            int cursor = inBounds(x, y) ? cellIndex(x, y) : -1;
+            std::size_t end = k;
+
+            for (; end < commands.size() &&
+                   commands[end].type == CommandType::MOVE_CURSOR;
+                 ++end) {
+                if (commands[end].arg > RIGHT) {
+                    results[end] = CommandResult::INVALID;
+                    continue;
+                }
+
+                // Only the first move can start off a tile.
+                Direction d = static_cast<Direction>(commands[end].arg);
+                bool open = false;
+                if (cursor < 0 || cell(cursor) == nullptr) {
+                    open = checkMove(d);
+                } else if (chunk(cursor).neighborMasks[cellSlot(cursor)] &
+                           ~(chunk(cursor).gateMasks[cellSlot(cursor)] >>
+                             ACTIVE_SHIFT) &
+                           edgeBit(d)) {
+                    int j = neighborCell(cursor, d);
+                    open = chunk(j).types[cellSlot(j)] != TileType::COLLISION;
+                }
+
+                if (!open) {
+                    results[end] = CommandResult::BLOCKED;
+                    continue;
+                }
+
+                toX += directionDX(d);
+                toY += directionDY(d);
+                cursor = cellIndex(toX, toY);
+            }
+
+            if (toX != x || toY != y) {
+                record({BoardChange::SET_CURSOR, 0, x, y, cell(cursor),
+                        nullptr});
+                placeCursor(toX, toY);
+            }
+
+            k = end - 1;
+            break;
+        }
+        case CommandType::ROTATE_TILES: {
+            // Sum up the quarter turns of the whole run first.
+            int turns = 0;
+            std::size_t end = k;
+            for (; end < commands.size() &&
+                   commands[end].type == CommandType::ROTATE_TILES &&
+                   commands[end].color == c.color;
+                 ++end) {
+                unsigned char r = commands[end].arg;
+                if (r == CLOCKWISE)
+                    ++turns;
+                else if (r == COUNTER_CLOCKWISE)
+                    turns += 3;
+                else
+                    results[end] = CommandResult::INVALID;
+            }
+
+            turns %= 4;
+            if (turns != 0 && c.color < m_colorBuckets->size()) {
+                Rotation r = turns == 3 ? COUNTER_CLOCKWISE : CLOCKWISE;
+                for (int t = 0; t < (turns == 2 ? 2 : 1); ++t) {
+                    record({BoardChange::ROTATE_TILES,
+                            static_cast<unsigned char>(r),
+                            static_cast<int>(c.color), 0, nullptr, nullptr});
+                    rotateBucket(c.color, r);
+                }
+            }
+
+            k = end - 1;
+            break;
+        }
+        case CommandType::TOGGLE_GATE: {
+            int e = handleEdge(c.gate);
+            if (e < 0)
+                results[k] = CommandResult::INVALID;
+            else
+                setEdgeActive(e, !edge(e)->isActive());
+            break;
+        }
+        default:
+            results[k] = CommandResult::INVALID;
+            break;
+        }
     }
+
+    return results;
 }
 
 bool Board::cursorOnGoal() const {
-    return m_cursor.getTile()->isGoal();
+    int x = m_cursor.getX(), y = m_cursor.getY();
+    if (!inBounds(x, y))
+        return false;
+
+    int i = cellIndex(x, y);
+    const BoardChunk &c = chunk(i);
+    return c.cells[cellSlot(i)] != nullptr &&
+           c.types[cellSlot(i)] == TileType::GOAL;
+}
+
+std::uint64_t Board::stateHash() const {
+    return m_hash;
+}
+
+Board Board::snapshot() const {
+    return Board{*this};
+}
+
+// +----------------------------------+
+// + Board handle functions           +
+// +----------------------------------+
+
+TileHandle Board::getTileHandle(const int &x, const int &y) const {
+    if (!inBounds(x, y))
+        return TileHandle{};
+
+    return tileHandle(cellIndex(x, y));
+}
+
+TileHandle Board::getTileHandle(const std::string &name) const {
+    auto it = m_tileNamesMap->find(name);
+    if (it == m_tileNamesMap->end())
+        return TileHandle{};
+
+    return tileHandle(it->second);
+}
+
+TileHandle Board::getTileHandle(const TileHandle &t,
+                                const Direction &d) const {
+    int i = handleCell(t);
+    if (i < 0 || !validDirection(d))
+        return TileHandle{};
+
+    if (!(chunk(i).neighborMasks[cellSlot(i)] & edgeBit(d)))
+        return TileHandle{};
+
+    return tileHandle(neighborCell(i, d));
+}
+
+GateHandle Board::getGateHandle(const std::string &name) const {
+    auto it = m_gateNamesMap->find(name);
+    if (it == m_gateNamesMap->end())
+        return GateHandle{};
+
+    return gateHandle(it->second);
+}
+
+GateHandle Board::getGateHandle(const TileHandle &t,
+                                const Direction &d) const {
+    int i = handleCell(t);
+    if (i < 0 || !validDirection(d))
+        return GateHandle{};
+
+    if (!(chunk(i).gateMasks[cellSlot(i)] & edgeBit(d)))
+        return GateHandle{};
+
+    return gateHandle(cellEdge(i, d));
+}
+
+TileHandle Board::getCursorHandle() const {
+    return getTileHandle(m_cursor.getX(), m_cursor.getY());
+}
+
+bool Board::valid(const TileHandle &h) const {
+    return handleCell(h) >= 0;
+}
+
+bool Board::valid(const GateHandle &h) const {
+    return handleEdge(h) >= 0;
+}
+
+const Tile *Board::getTile(const TileHandle &h) const {
+    int i = handleCell(h);
+    return i < 0 ? nullptr : cell(i).get();
+}
+
+const Gate *Board::getGate(const GateHandle &h) const {
+    int e = handleEdge(h);
+    return e < 0 ? nullptr : edge(e).get();
+}
+
+bool Board::getTileType(const TileHandle &h, TileType &type) const {
+    int i = handleCell(h);
+    if (i < 0)
+        return false;
+
+    type = chunk(i).types[cellSlot(i)];
+    return true;
+}
+
+bool Board::getNeighbors(const TileHandle &h,
+                         TileNeighbors &neighbors) const {
+    int i = handleCell(h);
+    if (i < 0)
+        return false;
+
+    const BoardChunk &c = chunk(i);
+    unsigned char tiles = c.neighborMasks[cellSlot(i)];
+    unsigned char gates = c.gateMasks[cellSlot(i)];
+    neighbors = TileNeighbors{};
+    neighbors.gated = gates & 0xf;
+    neighbors.active = gates >> ACTIVE_SHIFT;
+
+    neighbors.open = openMask(i);
+
+    for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+        if (neighbors.gated & edgeBit(d))
+            neighbors.gates[d] = gateHandle(cellEdge(i, d));
+        if (tiles & edgeBit(d))
+            neighbors.tiles[d] = tileHandle(neighborCell(i, d));
+    }
+
+    return true;
+}
+
+int Board::componentOf(const TileHandle &h) {
+    int i = handleCell(h);
+    if (i < 0 || !passable(i))
+        return -1;
+
+    updateComponents();
+    return findComponent(i);
+}
+
+bool Board::reachable(const TileHandle &from, const TileHandle &to) {
+    int i = handleCell(from), j = handleCell(to);
+    if (i < 0 || j < 0)
+        return false;
+    else if (i == j)
+        return true;
+    else if (!passable(j))
+        return false;
+
+    updateComponents();
+    int target = findComponent(j);
+    if (passable(i))
+        return findComponent(i) == target;
+
+    // The cursor can still step off a collision tile it was put on.
+    unsigned char open = openMask(i);
+    for (Direction d : {UP, DOWN, LEFT, RIGHT})
+        if ((open & edgeBit(d)) && findComponent(neighborCell(i, d)) == target)
+            return true;
+
+    return false;
+}
+
+void Board::remove(const TileHandle &h) {
+    int i = handleCell(h);
+
+    if (i < 0) {
+        ErrorMessage T_NF{name::PONE_GLOBAL_NAME, name::BOARD_REM3,
+                          "Stale tile handle."};
+        throw InvalidTileException(T_NF);
+    }
+
+    removeCell(i);
+}
+
+void Board::remove(const GateHandle &h) {
+    int e = handleEdge(h);
+
+    if (e < 0) {
+        ErrorMessage G_NF{name::PONE_GLOBAL_NAME, name::BOARD_REM4,
+                          "Stale gate handle."};
+        throw InvalidGateException(G_NF);
+    }
+
+    removeEdge(e);
+}
+
+void Board::rotateTile(const TileHandle &h, const Rotation &r) {
+    int i = handleCell(h);
+
+    if (i < 0) {
+        ErrorMessage T_NF{name::PONE_GLOBAL_NAME, name::BOARD_ROTT2,
+                          "Stale tile handle."};
+        throw InvalidTileException(T_NF);
+    }
+
+    rotateCell(i, r);
+}
+
+void Board::setGateActive(const GateHandle &h, bool active) {
+    int e = handleEdge(h);
+
+    if (e < 0) {
+        ErrorMessage G_NF{name::PONE_GLOBAL_NAME, name::BOARD_SETGACTIVE2,
+                          "Stale gate handle."};
+        throw InvalidGateException(G_NF);
+    }
+
+    setEdgeActive(e, active);
+}
+
+void Board::toggleGate(const GateHandle &h) {
+    int e = handleEdge(h);
+
+    if (e < 0) {
+        ErrorMessage G_NF{name::PONE_GLOBAL_NAME, name::BOARD_TOGGLEG2,
+                          "Stale gate handle."};
+        throw InvalidGateException(G_NF);
+    }
+
+    setEdgeActive(e, !edge(e)->isActive());
+}
+
+void Board::setCursorTile(const TileHandle &h) {
+    int i = handleCell(h);
+
+    if (i < 0) {
+        ErrorMessage T_NF{name::PONE_GLOBAL_NAME, name::BOARD_SETCSRT2,
+                          "Stale tile handle."};
+        throw InvalidTileException(T_NF);
+    }
+
+    record({BoardChange::SET_CURSOR, 0, m_cursor.getX(), m_cursor.getY(),
+            cell(i), nullptr});
+    placeCursor(cellX(i), cellY(i));
+}
+
+// +----------------------------------+
+// + Board journal functions          +
+// +----------------------------------+
+
+bool Board::undo() {
+    if (!canUndo())
+        return false;
+
+    replay(m_journal[(m_journalHead + m_journalPos - 1) % m_journalCapacity],
+           true);
+    --m_journalPos;
+    return true;
+}
+
+bool Board::redo() {
+    if (!canRedo())
+        return false;
+
+    replay(m_journal[(m_journalHead + m_journalPos) % m_journalCapacity],
+           false);
+    ++m_journalPos;
+    return true;
+}
+
+bool Board::canUndo() const {
+    return m_journalPos > 0;
+}
+
+bool Board::canRedo() const {
+    return m_journalPos < m_journalEnd;
+}
+
+std::size_t Board::getJournalCapacity() const {
+    return m_journalCapacity;
+}
+
+void Board::setJournalCapacity(const std::size_t &capacity) {
+    clearJournal();
+    m_journal.shrink_to_fit();
+    m_journalCapacity = capacity;
+}
+
+void Board::clearJournal() {
+    m_journal.clear();
+    m_journalHead = m_journalEnd = m_journalPos = 0;
 }
 
 bool Board::empty() const {
@@ -352,14 +1996,48 @@ bool Board::empty() const {
 }
 
 bool Board::full() const {
-    return m_numTiles > m_length * m_width;
+    return m_numTiles >= m_length * m_width;
+}
+
+int Board::allocatedChunks() const {
+    return static_cast<int>(std::count_if(
+        m_chunks->begin(), m_chunks->end(),
+        [](const std::shared_ptr<BoardChunk> &c) { return c != nullptr; }));
 }
 
-const std::unordered_map<std::string, std::string> Board::clockwiseMap = {
-    {"up", "right"}, {"right", "down"}, {"down", "left"}, {"left", "up"}};
+void Board::clearDirtyChunks() {
+    if (std::any_of(m_dirtyChunks->begin(), m_dirtyChunks->end(),
+                    [](const std::uint64_t &w) { return w != 0; })) {
+        // unshare may replace the vector, so take both ends after it.
+        std::vector<std::uint64_t> &dirty = unshare(m_dirtyChunks);
+        std::fill(dirty.begin(), dirty.end(), 0);
+    }
+}
 
-const std::unordered_map<std::string, std::string> Board::counterClockwiseMap =
-    {{"up", "left"}, {"left", "down"}, {"down", "right"}, {"right", "up"}};
+std::uint64_t Board::getVersion() const {
+    return m_version;
+}
+
+BoardChanges Board::drainChanges() {
+    BoardChanges changes;
+    changes.version = m_version;
+    changes.reset = m_changesReset;
+    changes.records.reserve(m_changedCells.size());
+
+    for (int i : m_changedCells) {
+        changes.records.push_back({cellX(i), cellY(i), m_changeFlags[i]});
+        m_changeFlags[i] = 0;
+    }
+    m_changedCells.clear();
+
+    // Start tracking again from a clean slate.
+    if (m_changesReset) {
+        m_changeFlags.assign(cellLimit(), 0);
+        m_changesReset = false;
+    }
+
+    return changes;
+}
 
 Board::~Board() {}
 
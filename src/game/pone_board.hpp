@@ -1,5 +1,5 @@
 /*   Created:    2024-06-23
- *   Modified:   2026-05-04
+ *   Modified:   2026-10-17
  */
 
 #pragma once
@@ -7,12 +7,21 @@
 #include "pone_const.hpp"
 #include "pone_cursor.hpp"
 #include "pone_gate.hpp"
+#include "pone_handle.hpp"
 #include "pone_tile.hpp"
-#include "utils/avl.h"
+#include "utils/flat_hash_map.h"
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 namespace pone {
 
@@ -34,21 +43,19 @@ using GatePtr = std::shared_ptr<Gate>;
 // + Custom hasher functions and comparators   +
 // +-------------------------------------------+
 
-// TODO: Make a better hashing algorithm.
-
 /**
  * Hasher function for a CoordPair.
  *
  * @note A CoordPair is a coordinate pair of
- *       two integers: x, y.
+ *       two integers: x, y. Both are packed into
+ *       one 64-bit value and mixed with mix64.
  * @param coords a CoordPair.
  * @return a hash value.
  * @sa CoordPair
  */
 struct CoordPairHasher {
     std::size_t operator()(const CoordPair &coords) const {
-        return std::hash<int>{}(coords.first) ^
-               (std::hash<int>{}(coords.second) << 1);
+        return FlatHash<CoordPair>{}(coords);
     }
 };
 
@@ -172,7 +179,7 @@ struct compareTileByName {
  */
 struct compareGateByTilePair {
     std::strong_ordering operator()(const GatePtr g1, const GatePtr g2) {
-        TilePair tp1 = g1->getTilePair(), tp2 = g2->getTilePair();
+        const TilePair &tp1 = g1->getTilePair(), &tp2 = g2->getTilePair();
 
         auto cmp = compareTileByCoords()(tp1.first, tp2.first);
         if (cmp != 0)
@@ -194,39 +201,782 @@ struct compareGateByName {
     }
 };
 
-/**
- * Boards are the collection of all of the tiles,
- * Gates, cursors and where the puzzle is mapped on.
- */
-class Board {
+// +----------------------------------+
+// + Board storage                    +
+// +----------------------------------+
+
+/**
+ * A 16 x 16 block of grid cells, with the gates on their edges.
+ * Boards share chunks after a snapshot and copy a chunk only when
+ * they first write to it.
+ */
+struct BoardChunk {
+    static constexpr int SIDE_SHIFT = 4;
+    static constexpr int SIDE = 1 << SIDE_SHIFT; // Cells per chunk row
+    static constexpr int SHIFT = 2 * SIDE_SHIFT;
+    static constexpr int SIZE = 1 << SHIFT; // Cells per chunk
+
+    std::array<TilePtr, SIZE> cells;
+    std::array<GatePtr, 2 * SIZE> gateEdges; // Two edges per cell
+    std::array<unsigned char, SIZE> gateMasks{};
+    std::array<int, SIZE> bucketSlots;
+
+    // Type of the tile in each cell, so that movement does not have
+    // to follow the tile pointer.
+    std::array<TileType, SIZE> types{};
+
+    // Bit 1 << d is set if the cell toward Direction d holds a tile.
+    // Only kept up to date for cells that hold a tile themselves.
+    std::array<unsigned char, SIZE> neighborMasks{};
+
+    // Epoch of the board that may change each tile or gate object in
+    // place, or 0 if every board must copy it first.
+    std::array<std::uint32_t, SIZE> tileOwners{};
+    std::array<std::uint32_t, 2 * SIZE> gateOwners{};
+
+    // Generation of each slot for handles, bumped when it is emptied.
+    std::array<std::uint32_t, SIZE> tileGenerations;
+    std::array<std::uint32_t, 2 * SIZE> gateGenerations;
+
+    /**
+     * Constructs an empty chunk.
+     *
+     * @param generation the first generation of every slot.
+     */
+    explicit BoardChunk(const std::uint32_t &generation = 0) {
+        bucketSlots.fill(-1);
+        tileGenerations.fill(generation);
+        gateGenerations.fill(generation);
+    }
+};
+
+/**
+ * The chunks of a board grid, in cell order. A null chunk has
+ * no tiles or gates.
+ */
+using ChunkTable = std::vector<std::shared_ptr<BoardChunk>>;
+
+/**
+ * A name index, mapping names to cell or edge indices.
+ * Names can be looked up by std::string_view.
+ */
+using NameIndex = FlatHashMap<std::string, int>;
+
+/**
+ * Cell indices of directional tiles, bucketed by ColorID.
+ */
+using ColorBuckets = std::vector<std::vector<int>>;
+
+// +----------------------------------+
+// + Board journal                    +
+// +----------------------------------+
+
+/**
+ * The kinds of change recorded in a board journal.
+ */
+enum class BoardChange : unsigned char {
+    NONE,
+    MOVE_CURSOR,
+    SET_CURSOR,
+    ROTATE_TILE,
+    ROTATE_TILES,
+    ADD_TILE,
+    REMOVE_TILE,
+    ADD_GATE,
+    REMOVE_GATE,
+    SET_GATE_ACTIVE,
+    SET_TILE_COLOR,
+    SET_TILE_TYPE
+};
+
+/**
+ * One journal entry: just enough to replay a change in either
+ * direction. The meaning of the fields depends on the change:
+ *
+ *     MOVE_CURSOR      a, b = previous cursor, arg = Direction
+ *     SET_CURSOR       a, b = previous cursor, tile = new cursor tile
+ *     ROTATE_TILE      a = cell index, arg = Rotation
+ *     ROTATE_TILES     a = ColorID, arg = Rotation
+ *     ADD/REMOVE_TILE  tile, a = epoch of its owner
+ *     ADD/REMOVE_GATE  gate, a = epoch of its owner
+ *     SET_GATE_ACTIVE  gate, a = previous state, arg = new state
+ *     SET_TILE_COLOR   tile, a = previous ColorID, b = new ColorID
+ *     SET_TILE_TYPE    tile, a = previous TileType, b = new TileType
+ */
+struct BoardDelta {
+    BoardChange change{BoardChange::NONE};
+    unsigned char arg{0};
+    int a{0}, b{0};
+    TilePtr tile;
+    GatePtr gate;
+};
+
+/**
+ * The tiles and gates around a tile, indexed by Direction. Each mask
+ * holds bit 1 << d for Direction d.
+ */
+struct TileNeighbors {
+    std::array<TileHandle, 4> tiles; // Null where there is no tile
+    std::array<GateHandle, 4> gates; // Null where there is no gate
+    unsigned char gated{0};          // The edge has a gate
+    unsigned char active{0};         // The gate on the edge is active
+    unsigned char open{0};           // checkMove would allow the move
+};
+
+/**
+ * A cell that changed since the last Board::drainChanges, with a
+ * mask of what changed in it. Gates are reported on the cell that
+ * owns their edge: the lower left of the two tiles.
+ */
+struct BoardChangeRecord {
+    static constexpr unsigned char TILE = 1 << 0;       // Tile set or edited
+    static constexpr unsigned char CURSOR = 1 << 1;     // Cursor came or went
+    static constexpr unsigned char GATE_RIGHT = 1 << 2; // Gate toward x + 1
+    static constexpr unsigned char GATE_UP = 1 << 3;    // Gate toward y + 1
+
+    int x, y;
+    unsigned char changed;
+};
+
+/**
+ * The changes drained from a board.
+ */
+struct BoardChanges {
+    std::uint64_t version{0}; // Board version when drained
+    bool reset{false};        // Everything may have changed: rescan
+    std::vector<BoardChangeRecord> records; // Empty on a reset
+};
+
+// +----------------------------------+
+// + Board commands                   +
+// +----------------------------------+
+
+/**
+ * The kinds of command that Board::apply executes.
+ */
+enum class CommandType : unsigned char {
+    MOVE_CURSOR,
+    ROTATE_TILES,
+    TOGGLE_GATE
+};
+
+/**
+ * One command of a batch for Board::apply. Colors and gates are
+ * looked up when the command is built, so that a batch runs without
+ * any lookup by name.
+ */
+struct Command {
+    CommandType type{CommandType::MOVE_CURSOR};
+    unsigned char arg{0};    // Direction or Rotation
+    ColorID color{NO_COLOR}; // ROTATE_TILES only
+    GateHandle gate;         // TOGGLE_GATE only
+
+    /**
+     * Builds a command that moves the cursor, like tryMoveCursor.
+     *
+     * @param d the direction to move towards.
+     * @return the command.
+     */
+    static constexpr Command move(const Direction &d) {
+        return {CommandType::MOVE_CURSOR, static_cast<unsigned char>(d),
+                NO_COLOR, GateHandle{}};
+    }
+
+    /**
+     * Builds a command that rotates the tiles of a color, like
+     * rotateTiles.
+     *
+     * @param color the ColorID of the tiles.
+     * @param r the rotation to apply.
+     * @return the command.
+     */
+    static constexpr Command rotate(const ColorID &color, const Rotation &r) {
+        return {CommandType::ROTATE_TILES, static_cast<unsigned char>(r),
+                color, GateHandle{}};
+    }
+
+    /**
+     * Builds a command that toggles a gate, like toggleGate.
+     *
+     * @param g the handle of the gate.
+     * @return the command.
+     */
+    static constexpr Command toggle(const GateHandle &g) {
+        return {CommandType::TOGGLE_GATE, 0, NO_COLOR, g};
+    }
+};
+
+/**
+ * The outcome of one command of a batch.
+ */
+enum class CommandResult : unsigned char {
+    OK,      // Executed
+    BLOCKED, // A move that checkMove would not allow: nothing changed
+    INVALID  // A bad direction or rotation, or a stale gate handle
+};
+
+/**
+ * Boards are the collection of all of the tiles,
+ * Gates, cursors and where the puzzle is mapped on.
+ *
+ * @note Any number of threads may call the const functions of a board
+ *       or copy it at once, as long as no thread changes it. Use a
+ *       BoardPublisher to share a board that is being edited.
+ */
+class Board {
+    // +----------------------------------+
+    // + Board data members               +
+    // +----------------------------------+
+
+    std::string m_name;
+    int m_length, m_width; // ! - Remember to except this if not int!
+
+    // Chunked tile grid: the board is tiled with 16 x 16 chunks in
+    // row-major order, m_chunkColumns per row, and the cells of each
+    // chunk are row-major too. The tile at (x, y) lives at cell index
+    // i = (chunk << BoardChunk::SHIFT) | (y % 16) * 16 + x % 16.
+    // Chunks are only allocated once something is written to them, so
+    // an empty region of the board costs one null pointer per chunk.
+    //
+    // Gates live on the edges between cells. Every cell owns two edges,
+    // the one toward x + 1 (edge 2i) and the one toward y + 1 (2i + 1).
+    //
+    // Every cell also has a gate mask, one bit per Direction. The low
+    // nibble marks gated edges and the high nibble the active ones,
+    // and a bucket slot: its position within its color bucket, or -1.
+    //
+    // The table, the name indices and the color buckets are shared
+    // between snapshots and copied on their first write.
+    std::shared_ptr<ChunkTable> m_chunks;
+    int m_chunkColumns;
+    std::shared_ptr<NameIndex> m_tileNamesMap;
+    std::shared_ptr<NameIndex> m_gateNamesMap;
+    std::shared_ptr<ColorBuckets> m_colorBuckets;
+
+    // One bit per chunk, set when the chunk is written to and cleared
+    // by clearDirtyChunks. Shared between snapshots like the chunks.
+    std::shared_ptr<std::vector<std::uint64_t>> m_dirtyChunks;
+
+    // Cell-level change set for drainChanges: the changed cells in
+    // order of their first change, and a BoardChangeRecord mask per
+    // cell index. Not shared with snapshots. While m_changesReset is
+    // set every cell counts as changed and nothing is tracked.
+    std::uint64_t m_version; // Bumped by every change
+    std::vector<int> m_changedCells;
+    std::vector<unsigned char> m_changeFlags;
+    bool m_changesReset;
+
+    // Connectivity index for reachable and componentOf: a union-find
+    // forest over cell indices. An entry >= 0 is the parent of a cell,
+    // a negative one marks a root and holds minus the size of its set.
+    // Edges that open are united right away; edges that close only
+    // mark the index stale, and the next query rebuilds it in one pass.
+    // Not shared with snapshots, which build their own when queried.
+    std::vector<int> m_components;
+    bool m_componentsValid;
+
+    int m_numGates; // Number of gates
+    int m_numTiles; // Number of tiles
+
+    std::uint64_t m_hash; // Zobrist hash of the board state
+
+    Cursor m_cursor; // track the current tile being pointed by cursor
+
+    // Tiles and gates stamped with this epoch are owned by this board.
+    // Taking a snapshot gives both boards a new epoch; the source
+    // board is changed through an atomic_ref, see BoardPublisher.
+    mutable std::uint32_t m_epoch;
+
+    // First slot generation of the next grid. Bumped whenever the
+    // grid is rebuilt, so that old handles are unlikely to match.
+    std::uint32_t m_generation;
+
+    // Undo journal: a ring of at most m_journalCapacity deltas. Logical
+    // entry k lives in slot (m_journalHead + k) % m_journalCapacity;
+    // entries below m_journalPos can be undone, the rest up to
+    // m_journalEnd can be redone.
+    std::vector<BoardDelta> m_journal;
+    std::size_t m_journalCapacity;
+    std::size_t m_journalHead, m_journalEnd, m_journalPos;
+    bool m_replaying; // Set while undo/redo replays a delta
+
+    // +----------------------------------+
+    // + Board grid helpers               +
+    // +----------------------------------+
+
+    /**
+     * Checks if a coordinate pair lies within the board.
+     *
+     * @param x the horizontal position.
+     * @param y the vertical position.
+     *
+     * @return true if 0 <= x < length and 0 <= y < width,
+     *         otherwise false.
+     */
+    bool inBounds(const int &x, const int &y) const;
+
+    /**
+     * Gets the grid index of a coordinate pair.
+     *
+     * @note The coordinates must be in bounds.
+     * @param x the horizontal position.
+     * @param y the vertical position.
+     *
+     * @return the index into the cell array.
+     */
+    int cellIndex(const int &x, const int &y) const;
+
+    /**
+     * Gets the horizontal position of a cell.
+     *
+     * @param i the cell index.
+     * @return the x-coordinate.
+     */
+    int cellX(const int &i) const;
+
+    /**
+     * Gets the vertical position of a cell.
+     *
+     * @param i the cell index.
+     * @return the y-coordinate.
+     */
+    int cellY(const int &i) const;
+
+    /**
+     * Gets the number of cell indices, counting the cells of
+     * partial chunks that hang off the board.
+     *
+     * @return one past the largest cell index.
+     */
+    int cellLimit() const;
+
+    /**
+     * Marks a chunk as changed.
+     *
+     * @param k the chunk index.
+     */
+    void markDirty(const std::size_t &k);
+
+    /**
+     * Records a change to a cell for drainChanges and bumps the
+     * board version.
+     *
+     * @param i the cell index.
+     * @param changed the BoardChangeRecord bits to set.
+     */
+    void touchCell(const int &i, const unsigned char &changed);
+
+    /**
+     * Records a change to the gate on an edge for drainChanges.
+     *
+     * @param e the edge index.
+     */
+    void touchEdge(const int &e);
+
+    /**
+     * Drops the tracked changes and reports a reset on the next
+     * drainChanges instead.
+     */
+    void resetChanges();
+
+    /**
+     * Gets the index of the edge between two adjacent cells.
+     *
+     * @param x1 the horizontal position of the first cell.
+     * @param y1 the vertical position of the first cell.
+     * @param x2 the horizontal position of the second cell.
+     * @param y2 the vertical position of the second cell.
+     *
+     * @return the edge index, otherwise -1 if the cells are
+     *         not adjacent or out of bounds.
+     */
+    int edgeIndex(const int &x1, const int &y1, const int &x2,
+                  const int &y2) const;
+
+    /**
+     * Gets the chunk holding a cell, for reading.
+     *
+     * @param i the cell index.
+     * @return the chunk, or a shared empty chunk if the chunk
+     *         has not been allocated.
+     */
+    const BoardChunk &chunk(const int &i) const;
+
+    /**
+     * Gets the chunk holding a cell, for writing. Allocates the
+     * chunk if needed, copies it first if it is shared with a
+     * snapshot, and marks it dirty.
+     *
+     * @param i the cell index.
+     * @return the chunk.
+     */
+    BoardChunk &writableChunk(const int &i);
+
+    /**
+     * Gets the tile in a cell.
+     *
+     * @param i the cell index.
+     * @return the tile, or nullptr if the cell is empty.
+     */
+    const TilePtr &cell(const int &i) const;
+
+    /**
+     * Gets the gate on an edge.
+     *
+     * @param e the edge index.
+     * @return the gate, or nullptr if the edge has no gate.
+     */
+    const GatePtr &edge(const int &e) const;
+
+    /**
+     * Gets the tile in a cell for changing it. Copies the tile
+     * first if this board does not own it.
+     *
+     * @param i the index of a cell holding a tile.
+     * @return the tile.
+     */
+    const TilePtr &writableTile(const int &i);
+
+    /**
+     * Gets the gate on an edge for changing it. Copies the gate
+     * first if this board does not own it.
+     *
+     * @param e the index of an edge holding a gate.
+     * @return the gate.
+     */
+    const GatePtr &writableGate(const int &e);
+
+    /**
+     * Gets the index of an adjacent cell without leaving the
+     * cell index space.
+     *
+     * @note The adjacent cell must be on the board.
+     * @param i the cell index.
+     * @param d the direction of the adjacent cell.
+     * @return the index of the adjacent cell.
+     */
+    int neighborCell(const int &i, const Direction &d) const;
+
+    /**
+     * Gets the index of the edge of a cell toward a direction.
+     *
+     * @note The adjacent cell must be on the board.
+     * @param i the cell index.
+     * @param d the direction of the edge.
+     * @return the edge index.
+     */
+    int cellEdge(const int &i, const Direction &d) const;
+
+    /**
+     * Computes the neighbor mask of a cell from the grid.
+     *
+     * @param i the cell index.
+     * @return bit 1 << d set for each Direction d with a tile.
+     */
+    unsigned char neighborMask(const int &i) const;
+
+    /**
+     * Updates the neighbor masks of a cell and of the tiles around
+     * it after a tile is placed in or taken out of the cell.
+     *
+     * @param i the cell index.
+     * @param present true if the cell now holds a tile.
+     */
+    void linkCell(const int &i, bool present);
+
+    /**
+     * Recomputes the neighbor mask of every tile on the board.
+     */
+    void linkAll();
+
+    // +----------------------------------+
+    // + Board connectivity helpers       +
+    // +----------------------------------+
+
+    /**
+     * Checks if the cursor can stand on a cell.
+     *
+     * @param i the cell index.
+     * @return true if the cell holds a tile that is not a collision
+     *         tile, otherwise false.
+     */
+    bool passable(const int &i) const;
+
+    /**
+     * Gets the directions in which the cursor could leave a cell:
+     * toward passable tiles, through no active gate.
+     *
+     * @note The cell must hold a tile.
+     * @param i the cell index.
+     * @return a mask with bit 1 << d for each open Direction d.
+     */
+    unsigned char openMask(const int &i) const;
+
+    /**
+     * Finds the root of the component of a cell.
+     *
+     * @note The connectivity index must be valid.
+     * @param i the cell index.
+     * @return the cell index of the root.
+     */
+    int findComponent(const int &i);
+
+    /**
+     * Merges the components of two cells.
+     *
+     * @param i the first cell index.
+     * @param j the second cell index.
+     */
+    void uniteComponents(const int &i, const int &j);
+
+    /**
+     * Updates the connectivity index for a cell that became
+     * passable, if the index is valid.
+     *
+     * @param i the cell index.
+     */
+    void openCell(const int &i);
+
+    /**
+     * Updates the connectivity index for an edge that opened, if the
+     * index is valid.
+     *
+     * @param e the edge index.
+     */
+    void openEdge(const int &e);
+
+    /**
+     * Rebuilds the connectivity index if it is stale.
+     */
+    void updateComponents();
+
+    /**
+     * Finds the cell of a tile: the one at its coordinates, if the
+     * tile there has the same name.
+     *
+     * @param t the tile.
+     * @return the cell index, otherwise -1 if the tile
+     *         is not on the board.
+     */
+    int tileCell(const TilePtr &t) const;
+
+    /**
+     * Finds the edge of a gate: the one with its name, if the gate
+     * there is between the same tile coordinates.
+     *
+     * @param g the gate.
+     * @return the edge index, otherwise -1 if the gate
+     *         is not on the board.
+     */
+    int gateEdge(const GatePtr &g) const;
+
+    /**
+     * Gets the handle of the tile in a cell.
+     *
+     * @param i the cell index.
+     * @return the handle, or a null handle if the cell is empty.
+     */
+    TileHandle tileHandle(const int &i) const;
+
+    /**
+     * Gets the handle of the gate on an edge.
+     *
+     * @param e the edge index.
+     * @return the handle, or a null handle if the edge has no gate.
+     */
+    GateHandle gateHandle(const int &e) const;
+
+    /**
+     * Resolves a tile handle.
+     *
+     * @param h the handle.
+     * @return the cell index, otherwise -1 if the handle is stale.
+     */
+    int handleCell(const TileHandle &h) const;
+
+    /**
+     * Resolves a gate handle.
+     *
+     * @param h the handle.
+     * @return the edge index, otherwise -1 if the handle is stale.
+     */
+    int handleEdge(const GateHandle &h) const;
+
+    /**
+     * Removes the tile in a cell.
+     *
+     * @param i the index of a cell holding a tile.
+     */
+    void removeCell(const int &i);
+
+    /**
+     * Removes the gate on an edge.
+     *
+     * @param e the index of an edge holding a gate.
+     */
+    void removeEdge(const int &e);
+
+    /**
+     * Rotates the tile in a cell.
+     *
+     * @param i the index of a cell holding a tile.
+     * @param r the rotation to apply.
+     */
+    void rotateCell(const int &i, const Rotation &r);
+
+    /**
+     * Turns the gate on an edge on or off.
+     *
+     * @param e the index of an edge holding a gate.
+     * @param active true to turn the gate on, false to turn it off.
+     */
+    void setEdgeActive(const int &e, bool active);
+
+    /**
+     * Reallocates the grid for new dimensions, keeping every
+     * tile and gate at its coordinates.
+     *
+     * @param length the new length of the board.
+     * @param width the new width of the board.
+     */
+    void resize(const int &length, const int &width);
+
+    /**
+     * Refreshes the gate masks of the two cells sharing an edge.
+     *
+     * @param e the edge index.
+     */
+    void updateGateMasks(const int &e);
+
+    /**
+     * Gets the Zobrist key of the tile in a cell.
+     *
+     * @param i the cell index.
+     * @return the key, or 0 if the cell is empty.
+     */
+    std::uint64_t tileKey(const int &i) const;
+
+    /**
+     * Gets the Zobrist key of the gate on an edge.
+     *
+     * @param e the edge index.
+     * @return the key, or 0 if the edge has no gate.
+     */
+    std::uint64_t gateKey(const int &e) const;
+
+    /**
+     * Gets the Zobrist key of the cursor position.
+     *
+     * @return the key.
+     */
+    std::uint64_t cursorKey() const;
+
+    /**
+     * Recomputes the Zobrist hash from scratch.
+     */
+    void rehash();
+
+    /**
+     * Adds the tile in a cell to its color bucket
+     * if it is directional.
+     *
+     * @param i the cell index.
+     */
+    void bucketTile(const int &i);
+
+    /**
+     * Removes the tile in a cell from its color bucket.
+     * Does nothing if the cell is not bucketed.
+     *
+     * @param i the cell index.
+     */
+    void unbucketTile(const int &i);
+
+    /**
+     * Moves the cursor to a position and marks the tile under it.
+     *
+     * @param x the horizontal position.
+     * @param y the vertical position.
+     */
+    void placeCursor(const int &x, const int &y);
+
+    /**
+     * Rotates every directional tile of a color.
+     *
+     * @param color the ColorID of the tiles.
+     * @param r the rotation to apply.
+     */
+    void rotateBucket(const ColorID &color, const Rotation &r);
+
+    /**
+     * Changes the color of the tile in a cell.
+     *
+     * @param i the cell index.
+     * @param color the new ColorID.
+     */
+    void recolorTile(const int &i, const ColorID &color);
+
+    /**
+     * Changes the type of the tile in a cell.
+     *
+     * @param i the cell index.
+     * @param type the new type.
+     */
+    void retypeTile(const int &i, const TileType &type);
+
+    /**
+     * Sets the type of the tile in a cell, without touching
+     * the hash or the color buckets.
+     *
+     * @param i the index of a cell holding a tile.
+     * @param type the new type.
+     */
+    void setCellType(const int &i, const TileType &type);
+
     // +----------------------------------+
-    // + Board data members               +
+    // + Board journal helpers            +
     // +----------------------------------+
 
-    std::string m_name;
-    int m_length, m_width; // ! - Remember to except this if not int!
-    AVL<TilePtr, compareTileByCoords>
-        m_tileCoordPairsTree; // A list of n * m tiles is needed for
-    AVL<TilePtr, compareTileByName> m_tileNamesTree;
-    AVL<GatePtr, compareGateByName> m_gateNamesTree;
-    AVL<GatePtr, compareGateByTilePair> m_gateTilePairsTree;
-
-    std::unordered_map<std::string, GatePtr> m_gateNamesMap;
-    std::unordered_map<TilePair, GatePtr, TilePairHasher, TilePairEquals>
-        m_gateTilePairsMap;
-    std::unordered_map<std::string, TilePtr> m_tileNamesMap;
-    std::unordered_map<CoordPair, TilePtr, CoordPairHasher, CoordPairEquals>
-        m_tileCoordPairsMap;
+    /**
+     * Appends a delta to the journal, dropping every delta that
+     * could still be redone and, when the journal is full, the
+     * oldest one. Does nothing while a delta is being replayed.
+     *
+     * @param delta the change that was just made.
+     */
+    void record(BoardDelta delta);
 
-    int m_numGates; // Number of gates
-    int m_numTiles; // Number of tiles
+    /**
+     * Puts a removed tile back on the board.
+     *
+     * @param t the tile.
+     * @param owner the epoch of its owner when it was removed.
+     */
+    void restore(const TilePtr &t, const std::uint32_t &owner);
 
-    Cursor m_cursor; // track the current tile being pointed by cursor
-    static const std::unordered_map<std::string, std::string> clockwiseMap;
-    static const std::unordered_map<std::string, std::string>
-        counterClockwiseMap;
+    /**
+     * Puts a removed gate back on the board.
+     *
+     * @param g the gate.
+     * @param owner the epoch of its owner when it was removed.
+     */
+    void restore(const GatePtr &g, const std::uint32_t &owner);
+
+    /**
+     * Replays a journal entry.
+     *
+     * @param delta the entry to replay.
+     * @param inverse true to revert the change, false to redo it.
+     */
+    void replay(const BoardDelta &delta, bool inverse);
 
   public:
+    /**
+     * The number of changes a board can undo unless
+     * setJournalCapacity says otherwise.
+     */
+    static constexpr std::size_t DEFAULT_JOURNAL_CAPACITY = 1024;
+
     // +----------------------------------+
     // + Board constructors               +
     // +----------------------------------+
@@ -259,6 +1009,25 @@ class Board {
     Board(const std::string &name, const int &length, const int &width,
           const int &cursor_x, const int &cursor_y);
 
+    /**
+     * Copies a board. Same as other.snapshot().
+     *
+     * @param other the board to copy.
+     */
+    Board(const Board &other);
+
+    Board(Board &&other) = default;
+
+    /**
+     * Replaces the board with a snapshot of another.
+     *
+     * @param other the board to copy.
+     * @return this board.
+     */
+    Board &operator=(const Board &other);
+
+    Board &operator=(Board &&other) = default;
+
     // +----------------------------------+
     // + Board functions                  +
     // +----------------------------------+
@@ -360,6 +1129,35 @@ class Board {
      */
     GatePtr getGate(const TilePtr &t, const Direction &d) const;
 
+    /**
+     * Calls a function on every tile inside a rectangle,
+     * row by row. The rectangle is clipped to the board, so
+     * the work done is proportional to the visible cells.
+     *
+     * @param x0 the x-coordinate of the lower left corner.
+     * @param y0 the y-coordinate of the lower left corner.
+     * @param x1 the x-coordinate of the upper right corner.
+     * @param y1 the y-coordinate of the upper right corner.
+     * @param fn a function called with each tile's TilePtr.
+     */
+    template <typename F>
+    void forEachTileIn(const int &x0, const int &y0, const int &x1,
+                       const int &y1, F &&fn) const;
+
+    /**
+     * Calls a function on every gate with at least one of
+     * its tiles inside a rectangle, once per gate.
+     *
+     * @param x0 the x-coordinate of the lower left corner.
+     * @param y0 the y-coordinate of the lower left corner.
+     * @param x1 the x-coordinate of the upper right corner.
+     * @param y1 the y-coordinate of the upper right corner.
+     * @param fn a function called with each gate's GatePtr.
+     */
+    template <typename F>
+    void forEachGateIn(const int &x0, const int &y0, const int &x1,
+                       const int &y1, F &&fn) const;
+
     /**
      * Gets the tile that the cursor is on.
      *
@@ -436,6 +1234,7 @@ class Board {
     void remove(const TilePtr &t);
 
     /** Adds a gate to the board.
+     * Both of its tiles must be adjacent and already on the board.
      *
      * @param g the gate to add.
      */
@@ -447,6 +1246,58 @@ class Board {
      */
     void remove(const GatePtr &g);
 
+    /**
+     * Replaces every tile and gate on the board at once, in time
+     * linear in the size of the board. Use this over repeated add
+     * calls to load a level.
+     *
+     * @note The tiles share one allocation, as do the gates: memory
+     *       is only given back once none of them is referenced.
+     *       Clears the journal.
+     * @param tiles the new tiles.
+     * @param gates the new gates, between tiles at the same
+     *        coordinates as the new tiles. Each gate is rebound to
+     *        the new tiles at its coordinates.
+     */
+    void assign(std::vector<Tile> tiles, std::vector<Gate> gates);
+
+    /**
+     * Changes the color of a tile on the board.
+     *
+     * @note Recolor tiles on the board through this function rather
+     *       than Tile::setColor so that rotateTiles can find them.
+     * @param t the tile to recolor.
+     * @param color the new color.
+     */
+    void setTileColor(const TilePtr &t, const std::string &color);
+
+    /**
+     * Changes the type of a tile on the board.
+     *
+     * @note Retype tiles on the board through this function rather
+     *       than Tile::setType so that rotateTiles can find them.
+     * @param t the tile to change.
+     * @param type the new type.
+     */
+    void setTileType(const TilePtr &t, const std::string &type);
+
+    /**
+     * Turns a gate on the board on or off.
+     *
+     * @note Toggle gates on the board through this function rather
+     *       than Gate::setActive so that checkMove sees the change.
+     * @param g the gate.
+     * @param active true to turn the gate on, false to turn it off.
+     */
+    void setGateActive(const GatePtr &g, bool active);
+
+    /**
+     * Flips a gate on the board between on and off.
+     *
+     * @param g the gate.
+     */
+    void toggleGate(const GatePtr &g);
+
     /**
      * Loads a board via a YAML file.
      *
@@ -478,6 +1329,51 @@ class Board {
      */
     bool full() const;
 
+    /**
+     * Gets the number of chunks holding storage. Memory use grows
+     * with this number rather than with length * width.
+     *
+     * @return the number of allocated chunks.
+     */
+    int allocatedChunks() const;
+
+    /**
+     * Calls a function on the rectangle of every chunk changed since
+     * the last call to clearDirtyChunks, so that a renderer can
+     * redraw only those parts of the board.
+     *
+     * @note Resizing or assigning the board marks every chunk.
+     * @param fn a function called with the lower left and upper right
+     *           corners (x0, y0, x1, y1) of each rectangle, clipped to
+     *           the board.
+     */
+    template <typename F> void forEachDirtyChunk(F &&fn) const;
+
+    /**
+     * Clears every chunk-level dirty flag.
+     */
+    void clearDirtyChunks();
+
+    /**
+     * Gets the board version. Every change to the tiles, gates or
+     * cursor increases it, so equal versions mean an unchanged board.
+     *
+     * @return the version.
+     */
+    std::uint64_t getVersion() const;
+
+    /**
+     * Takes the cells changed since the last call, so that a consumer
+     * can update only those. Each cell is reported once per drain,
+     * however often it changed.
+     *
+     * @note A new board, a snapshot, resizing or assigning the board,
+     *       or too many changes between drains report a reset
+     *       instead of records.
+     * @return the changes, with the current version.
+     */
+    BoardChanges drainChanges();
+
     // +----------------------------------+
     // + Board game functions             +
     // +----------------------------------+
@@ -493,13 +1389,25 @@ class Board {
 
     /**
      * Checks if the next move toward a specified direction
-     * is valid.
+     * is valid. A move is blocked by a missing or collision tile,
+     * or by an active gate on the edge.
      *
      * @param d the direction to check.
      *
      * @return true if the move is valid, otherwise false.
      */
-    bool checkMove(const Direction &d);
+    bool checkMove(const Direction &d) const;
+
+    /**
+     * Moves the cursor one tile to a specified direction if
+     * checkMove allows it. A blocked move is not an error,
+     * so movement code can probe edges without exceptions.
+     *
+     * @param d the direction to move towards.
+     *
+     * @return true if the cursor moved, otherwise false.
+     */
+    bool tryMoveCursor(const Direction &d);
 
     /**
      * Rotates a directional tile.
@@ -512,6 +1420,7 @@ class Board {
 
     /**
      * Rotates a group of tiles based on color.
+     * Only the directional tiles of that color are visited.
      *
      * @param color the color of the tiles.
      * @param r the rotation to apply to the tile.
@@ -519,6 +1428,33 @@ class Board {
     void rotateTiles(const std::string &color,
                      const Rotation &r); // Rotate all tiles on board
 
+    /**
+     * Rotates a group of tiles based on an interned color.
+     * Unlike the name overload, this never touches the color
+     * registry, so hot loops should intern the color once and
+     * call this.
+     *
+     * @param color the color of the tiles.
+     * @param r the rotation to apply to the tile.
+     */
+    void rotateTiles(const ColorID &color, const Rotation &r);
+
+    /**
+     * Executes a batch of commands in order, in one pass. A command
+     * that cannot run is skipped and reported instead of throwing, and
+     * the rest of the batch still runs.
+     *
+     * Runs of consecutive commands are merged. A run of moves is
+     * walked on the grid and the cursor is placed once, where it ends
+     * up. A run of rotations of the same color visits the tiles of
+     * that color at most twice. The journal and drainChanges only
+     * see the net effect of each run.
+     *
+     * @param commands the commands.
+     * @return one result per command, in the same order.
+     */
+    std::vector<CommandResult> apply(std::span<const Command> commands);
+
     /**
      * Checks if the cursor is on the goal.
      *
@@ -526,6 +1462,287 @@ class Board {
      */
     bool cursorOnGoal() const;
 
+    /**
+     * Gets the Zobrist hash of the board state: the type and color
+     * of every tile, every gate and whether it is active, and the
+     * cursor position. It is updated incrementally by every
+     * Board function that changes the state.
+     *
+     * @note Tile names and IDs do not take part in the hash.
+     * @return a 64-bit hash. Equal states have equal hashes.
+     */
+    std::uint64_t stateHash() const;
+
+    /**
+     * Takes a snapshot of the board in O(1). The board and the
+     * snapshot share their storage, and whichever of them changes
+     * first copies only the chunk of cells, the tiles and the gates
+     * it touches.
+     *
+     * @note After a snapshot, pointers from getTile and getGate may
+     *       no longer be the objects the board changes; get them
+     *       again. Board functions find their tile and gate arguments
+     *       by name and position, so old pointers still work there.
+     *       The snapshot starts with an empty journal.
+     * @return the snapshot.
+     */
+    Board snapshot() const;
+
+    // +----------------------------------+
+    // + Board handle functions           +
+    // +----------------------------------+
+
+    // Handles identify tiles and gates by board slot rather than by
+    // pointer. They stay valid until their object is removed or the
+    // grid is rebuilt by setLength, setWidth or assign, and they are
+    // shared by the board and its snapshots.
+    //
+    // They sit alongside TilePtr and GatePtr rather than replacing
+    // them: slots still own their objects through shared_ptr, since
+    // snapshots, the journal and callers of the pointer API share
+    // those objects. Handles are the allocation-free path, not the
+    // only one. See pone_handle.hpp.
+
+    /**
+     * Gets a tile handle by coordinates.
+     *
+     * @param x the horizontal position of the tile.
+     * @param y the vertical position of the tile.
+     *
+     * @return the handle, otherwise a null handle if not found.
+     */
+    TileHandle getTileHandle(const int &x, const int &y) const;
+
+    /**
+     * Gets a tile handle by name.
+     *
+     * @param name the name of the tile.
+     * @return the handle, otherwise a null handle if not found.
+     */
+    TileHandle getTileHandle(const std::string &name) const;
+
+    /**
+     * Gets the handle of a tile adjacent to another.
+     *
+     * @param t the source tile.
+     * @param d the direction from the source tile to the adjacent tile.
+     *
+     * @return the handle, otherwise a null handle if t is stale
+     *         or there is no tile there.
+     */
+    TileHandle getTileHandle(const TileHandle &t, const Direction &d) const;
+
+    /**
+     * Gets a gate handle by name.
+     *
+     * @param name the name of the gate.
+     * @return the handle, otherwise a null handle if not found.
+     */
+    GateHandle getGateHandle(const std::string &name) const;
+
+    /**
+     * Gets the handle of the gate next to a tile.
+     *
+     * @param t the source tile.
+     * @param d the direction from the source tile to the gate.
+     *
+     * @return the handle, otherwise a null handle if t is stale
+     *         or there is no gate there.
+     */
+    GateHandle getGateHandle(const TileHandle &t, const Direction &d) const;
+
+    /**
+     * Gets the handle of the tile that the cursor is on.
+     *
+     * @return the handle, otherwise a null handle if the cursor
+     *         is not on a tile.
+     */
+    TileHandle getCursorHandle() const;
+
+    /**
+     * Checks if a tile handle refers to a tile on the board.
+     *
+     * @param h the handle.
+     * @return true if the handle is valid, otherwise false.
+     */
+    bool valid(const TileHandle &h) const;
+
+    /**
+     * Checks if a gate handle refers to a gate on the board.
+     *
+     * @param h the handle.
+     * @return true if the handle is valid, otherwise false.
+     */
+    bool valid(const GateHandle &h) const;
+
+    /**
+     * Gets a tile by handle, without sharing ownership of it.
+     *
+     * @note The pointer is only good until the next change
+     *       to the board.
+     * @param h the handle.
+     * @return the tile, otherwise nullptr if the handle is stale.
+     */
+    const Tile *getTile(const TileHandle &h) const;
+
+    /**
+     * Gets a gate by handle, without sharing ownership of it.
+     *
+     * @note The pointer is only good until the next change
+     *       to the board.
+     * @param h the handle.
+     * @return the gate, otherwise nullptr if the handle is stale.
+     */
+    const Gate *getGate(const GateHandle &h) const;
+
+    /**
+     * Gets the type of a tile by handle, without following
+     * the tile pointer.
+     *
+     * @param h the handle.
+     * @param type set to the type of the tile.
+     * @return true if the handle is valid, otherwise false.
+     */
+    bool getTileType(const TileHandle &h, TileType &type) const;
+
+    /**
+     * Gets the four tiles and gates around a tile, and the state
+     * of each edge, in one call.
+     *
+     * @param h the handle.
+     * @param neighbors set to the neighbors of the tile.
+     * @return true if the handle is valid, otherwise false.
+     */
+    bool getNeighbors(const TileHandle &h, TileNeighbors &neighbors) const;
+
+    /**
+     * Gets the component of a tile: the set of tiles the cursor could
+     * walk between on the board as it is now.
+     *
+     * @note Not a const function: it may have to rebuild the index
+     *       after gates were activated or tiles removed. Component IDs
+     *       can change with every change to the board.
+     * @param h the handle.
+     * @return the ID of the component, otherwise -1 if the handle is
+     *         stale or the tile is a collision tile.
+     */
+    int componentOf(const TileHandle &h);
+
+    /**
+     * Checks if the cursor could walk from one tile to another on the
+     * board as it is now, without rotating tiles or toggling gates.
+     *
+     * @note Not a const function, see componentOf.
+     * @param from the handle of the start tile.
+     * @param to the handle of the destination tile.
+     * @return true if there is such a walk, otherwise false, or if
+     *         either handle is stale.
+     */
+    bool reachable(const TileHandle &from, const TileHandle &to);
+
+    /**
+     * Removes a tile by handle.
+     *
+     * @param h the handle of the tile.
+     */
+    void remove(const TileHandle &h);
+
+    /**
+     * Removes a gate by handle.
+     *
+     * @param h the handle of the gate.
+     */
+    void remove(const GateHandle &h);
+
+    /**
+     * Rotates a directional tile by handle.
+     *
+     * @param h the handle of the tile.
+     * @param r the rotation to apply to the tile.
+     */
+    void rotateTile(const TileHandle &h, const Rotation &r);
+
+    /**
+     * Turns a gate on or off by handle.
+     *
+     * @param h the handle of the gate.
+     * @param active true to turn the gate on, false to turn it off.
+     */
+    void setGateActive(const GateHandle &h, bool active);
+
+    /**
+     * Flips a gate between on and off by handle.
+     *
+     * @param h the handle of the gate.
+     */
+    void toggleGate(const GateHandle &h);
+
+    /**
+     * Sets the cursor to a tile by handle.
+     *
+     * @param h the handle of the destination tile.
+     */
+    void setCursorTile(const TileHandle &h);
+
+    // +----------------------------------+
+    // + Board journal functions          +
+    // +----------------------------------+
+
+    /**
+     * Reverts the most recent change made through moveCursor,
+     * setCursorTile, rotateTile, rotateTiles, add, remove,
+     * setGateActive, toggleGate, setTileColor or setTileType.
+     *
+     * @return true if a change was reverted, otherwise false
+     *         if there is nothing to undo.
+     */
+    bool undo();
+
+    /**
+     * Reapplies the most recently undone change.
+     * Any new change drops the changes that could be redone.
+     *
+     * @return true if a change was reapplied, otherwise false
+     *         if there is nothing to redo.
+     */
+    bool redo();
+
+    /**
+     * Checks if there is a change to undo.
+     *
+     * @return true if undo would succeed, otherwise false.
+     */
+    bool canUndo() const;
+
+    /**
+     * Checks if there is a change to redo.
+     *
+     * @return true if redo would succeed, otherwise false.
+     */
+    bool canRedo() const;
+
+    /**
+     * Gets the maximum number of changes kept in the journal.
+     *
+     * @return the capacity.
+     */
+    std::size_t getJournalCapacity() const;
+
+    /**
+     * Sets the maximum number of changes kept in the journal,
+     * bounding its memory use. Clears the journal.
+     *
+     * @param capacity the new capacity, 0 to turn the journal off.
+     */
+    void setJournalCapacity(const std::size_t &capacity);
+
+    /**
+     * Forgets every change that could be undone or redone.
+     *
+     * @note Resizing the board also clears the journal.
+     */
+    void clearJournal();
+
     // +----------------------------------+
     // + Board debug functions            +
     // +----------------------------------+
@@ -537,4 +1754,112 @@ class Board {
     ~Board();
 };
 
+// +----------------------------------+
+// + Board template functions         +
+// +----------------------------------+
+
+template <typename F>
+void Board::forEachTileIn(const int &x0, const int &y0, const int &x1,
+                          const int &y1, F &&fn) const {
+    int left = std::max(x0, 0), right = std::min(x1, m_length - 1);
+    int bottom = std::max(y0, 0), top = std::min(y1, m_width - 1);
+    constexpr int SIDE = BoardChunk::SIDE;
+    if (left > right)
+        return;
+
+    // Each row crosses a run of chunks; look up each chunk once per
+    // row rather than once per cell, and skip unallocated ones.
+    for (int y = bottom; y <= top; ++y) {
+        int row = (y % SIDE) * SIDE;
+        for (int cx = left / SIDE; cx <= right / SIDE; ++cx) {
+            const std::shared_ptr<BoardChunk> &c =
+                (*m_chunks)[(y / SIDE) * m_chunkColumns + cx];
+            if (c == nullptr)
+                continue;
+
+            int first = std::max(left, cx * SIDE) % SIDE;
+            int last = std::min(right, cx * SIDE + SIDE - 1) % SIDE;
+            for (int x = first; x <= last; ++x)
+                if (const TilePtr &t = c->cells[row + x])
+                    fn(t);
+        }
+    }
+}
+
+template <typename F>
+void Board::forEachGateIn(const int &x0, const int &y0, const int &x1,
+                          const int &y1, F &&fn) const {
+    int left = std::max(x0, 0), right = std::min(x1, m_length - 1);
+    int bottom = std::max(y0, 0), top = std::min(y1, m_width - 1);
+    if (left > right || bottom > top)
+        return;
+
+    // Every gate is stored on the edge leaving its lower left tile,
+    // so the rectangle plus the column to its left and the row below
+    // it hold each gate touching the rectangle exactly once.
+    auto visit = [&](const int &e) {
+        if (const GatePtr &g = edge(e))
+            fn(g);
+    };
+
+    for (int y = bottom; y <= top; ++y) {
+        if (left > 0)
+            visit(2 * cellIndex(left - 1, y));
+        for (int x = left; x <= right; ++x) {
+            int i = cellIndex(x, y);
+            visit(2 * i);
+            visit(2 * i + 1);
+        }
+    }
+
+    if (bottom > 0)
+        for (int x = left; x <= right; ++x)
+            visit(2 * cellIndex(x, bottom - 1) + 1);
+}
+
+template <typename F> void Board::forEachDirtyChunk(F &&fn) const {
+    const std::vector<std::uint64_t> &words = *m_dirtyChunks;
+    constexpr int SIDE = BoardChunk::SIDE;
+
+    for (std::size_t w = 0; w < words.size(); ++w) {
+        for (std::uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+            int k = static_cast<int>(64 * w) + std::countr_zero(bits);
+            int x0 = (k % m_chunkColumns) * SIDE;
+            int y0 = (k / m_chunkColumns) * SIDE;
+            fn(x0, y0, std::min(x0 + SIDE, m_length) - 1,
+               std::min(y0 + SIDE, m_width) - 1);
+        }
+    }
+}
+
+/**
+ * The query, edit and movement API shared by every board backend,
+ * so game code can be written against either backend.
+ */
+template <typename B>
+concept BoardBackend = requires(B b, const B cb, const Direction &d,
+                                const Rotation &r, const std::string &c,
+                                const ColorID &id, const int &x,
+                                const int &y, const TilePtr &t,
+                                const GatePtr &g) {
+    { cb.getName() } -> std::same_as<std::string>;
+    { cb.getLength() } -> std::same_as<int>;
+    { cb.getWidth() } -> std::same_as<int>;
+    { cb.empty() } -> std::same_as<bool>;
+    { cb.full() } -> std::same_as<bool>;
+    { cb.getTile(x, y) } -> std::same_as<TilePtr>;
+    { cb.getGate(t, t) } -> std::same_as<GatePtr>;
+    { b.remove(t) } -> std::same_as<void>;
+    { b.remove(g) } -> std::same_as<void>;
+    { b.rotateTile(t, r) } -> std::same_as<void>;
+    { b.checkMove(d) } -> std::same_as<bool>;
+    { b.moveCursor(d) } -> std::same_as<void>;
+    { b.tryMoveCursor(d) } -> std::same_as<bool>;
+    { b.rotateTiles(c, r) } -> std::same_as<void>;
+    { b.rotateTiles(id, r) } -> std::same_as<void>;
+    { cb.cursorOnGoal() } -> std::same_as<bool>;
+};
+
+static_assert(BoardBackend<Board>);
+
 } // namespace pone
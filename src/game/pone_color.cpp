@@ -0,0 +1,76 @@
+/*   Created:    2026-10-17
+ *   Modified:   2026-10-17
+ */
+
+#include "pone_color.hpp"
+#include "pone_const.hpp"
+#include "pone_except.hpp"
+#include <deque>
+#include <format>
+#include <mutex>
+#include <unordered_map>
+
+namespace pone {
+
+namespace {
+
+/**
+ * Storage behind the ColorRegistry.
+ */
+struct ColorTable {
+    std::mutex mutex;
+    std::deque<std::string> names{"none"};
+    std::unordered_map<std::string, ColorID> ids{{"none", NO_COLOR}};
+};
+
+ColorTable &colorTable() {
+    static ColorTable table;
+    return table;
+}
+
+} // namespace
+
+ColorID ColorRegistry::intern(const std::string &color) {
+    ColorTable &table = colorTable();
+    std::lock_guard<std::mutex> lock{table.mutex};
+
+    auto [it, inserted] =
+        table.ids.try_emplace(color, static_cast<ColorID>(table.names.size()));
+    if (inserted)
+        table.names.push_back(color);
+
+    return it->second;
+}
+
+bool ColorRegistry::find(const std::string &color, ColorID &id) {
+    ColorTable &table = colorTable();
+    std::lock_guard<std::mutex> lock{table.mutex};
+
+    auto it = table.ids.find(color);
+    if (it == table.ids.end())
+        return false;
+
+    id = it->second;
+    return true;
+}
+
+std::string ColorRegistry::name(const ColorID &id) {
+    ColorTable &table = colorTable();
+    std::lock_guard<std::mutex> lock{table.mutex};
+
+    if (id >= table.names.size()) {
+        ErrorMessage CLR_NF{name::PONE_GLOBAL_NAME, name::COLOR_NAME,
+                            std::format("Unknown color ID {}.", id)};
+        throw InvalidValueException(CLR_NF);
+    }
+
+    return table.names[id];
+}
+
+std::size_t ColorRegistry::size() {
+    ColorTable &table = colorTable();
+    std::lock_guard<std::mutex> lock{table.mutex};
+    return table.names.size();
+}
+
+} // namespace pone
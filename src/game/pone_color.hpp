@@ -0,0 +1,68 @@
+/*   Created:    2026-10-17
+ *   Modified:   2026-10-17
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace pone {
+
+/**
+ * Represents an interned color.
+ */
+using ColorID = std::uint32_t;
+
+/**
+ * The ID of the color "none", the default color of tiles and gates.
+ */
+inline constexpr ColorID NO_COLOR = 0;
+
+/**
+ * Registry that interns color names into small integer IDs,
+ * so colors can be compared without string comparisons.
+ *
+ * @note IDs are never released. The registry is shared by every
+ *       board and is safe to use from multiple threads.
+ */
+class ColorRegistry {
+  public:
+    /**
+     * Interns a color name.
+     *
+     * @param color the name of the color.
+     *
+     * @return the ID of the color, allocating a new ID if the color
+     *         was not seen before.
+     */
+    static ColorID intern(const std::string &color);
+
+    /**
+     * Finds the ID of a color without interning it.
+     *
+     * @param color the name of the color.
+     * @param id set to the ID of the color if it was found.
+     *
+     * @return true if the color has been interned, otherwise false.
+     */
+    static bool find(const std::string &color, ColorID &id);
+
+    /**
+     * Gets the name of an interned color.
+     *
+     * @param id the ID of the color.
+     *
+     * @return the name of the color.
+     */
+    static std::string name(const ColorID &id);
+
+    /**
+     * Gets the number of interned colors.
+     *
+     * @return the number of colors, including "none".
+     */
+    static std::size_t size();
+};
+
+} // namespace pone
@@ -1,5 +1,5 @@
 /*   Created:    2024-08-15
- *   Modified:   2026-05-04
+ *   Modified:   2026-10-17
  */
 
 #pragma once
@@ -19,6 +19,22 @@ enum Direction { UP, DOWN, LEFT, RIGHT };
  */
 enum Rotation { CLOCKWISE, COUNTER_CLOCKWISE };
 
+/**
+ * All possible types of a tile.
+ */
+enum class TileType : unsigned char {
+    EMPTY,
+    GATE_SWITCH,
+    TILE_SWITCH,
+    KEY,
+    UP,
+    DOWN,
+    LEFT,
+    RIGHT,
+    GOAL,
+    COLLISION
+};
+
 namespace name {
 inline constexpr std::string_view PONE_GLOBAL_NAME = "pone::";
 
@@ -61,6 +77,26 @@ inline constexpr std::string_view BOARD_REM1 = "Board::remove(const TilePtr &)";
 inline constexpr std::string_view BOARD_ADD2 =
     "Board::add(const GatePtr &gptr)";
 inline constexpr std::string_view BOARD_REM2 = "Board::remove(const GatePtr &)";
+inline constexpr std::string_view BOARD_REM3 =
+    "Board::remove(const TileHandle &)";
+inline constexpr std::string_view BOARD_REM4 =
+    "Board::remove(const GateHandle &)";
+inline constexpr std::string_view BOARD_ASSIGN =
+    "Board::assign(std::vector<Tile>, std::vector<Gate>)";
+inline constexpr std::string_view BOARD_SETTCLR =
+    "Board::setTileColor(const TilePtr &, const std::string &)";
+inline constexpr std::string_view BOARD_SETTTYPE =
+    "Board::setTileType(const TilePtr &, const std::string &)";
+inline constexpr std::string_view BOARD_SETGACTIVE =
+    "Board::setGateActive(const GatePtr &, bool)";
+inline constexpr std::string_view BOARD_TOGGLEG =
+    "Board::toggleGate(const GatePtr &)";
+inline constexpr std::string_view BOARD_SETGACTIVE2 =
+    "Board::setGateActive(const GateHandle &, bool)";
+inline constexpr std::string_view BOARD_TOGGLEG2 =
+    "Board::toggleGate(const GateHandle &)";
+inline constexpr std::string_view BOARD_SETCSRT2 =
+    "Board::setCursorTile(const TileHandle &)";
 inline constexpr std::string_view BOARD_LOAD =
     "Board::load(const std::string &)";
 inline constexpr std::string_view BOARD_SAVE =
@@ -73,6 +109,8 @@ inline constexpr std::string_view BOARD_CHKMV =
     "Board::checkMove(const Direction &)";
 inline constexpr std::string_view BOARD_ROTT =
     "Board::rotateTile(const TilePtr &, const Rotation &)";
+inline constexpr std::string_view BOARD_ROTT2 =
+    "Board::rotateTile(const TileHandle &, const Rotation &)";
 inline constexpr std::string_view BOARD_ROTTS =
     "Board::rotateTiles(const std::string &, const Rotation &)";
 inline constexpr std::string_view BOARD_CSRGOAL = "Board::cursorOnGoal()";
@@ -80,6 +118,39 @@ inline constexpr std::string_view BOARD_BOARDD = "Board::~Board()";
 
 // End of pone::Board names
 
+// Start of pone::BitBoard names
+
+inline constexpr std::string_view BITBOARD_BITBOARD1 =
+    "BitBoard::BitBoard(const std::string &, const int &, const int &, "
+    "const int &, const int &)";
+inline constexpr std::string_view BITBOARD_BITBOARD2 =
+    "BitBoard::BitBoard(const Board &)";
+inline constexpr std::string_view BITBOARD_ADD1 =
+    "BitBoard::add(const TilePtr &)";
+inline constexpr std::string_view BITBOARD_ADD2 =
+    "BitBoard::add(const GatePtr &)";
+inline constexpr std::string_view BITBOARD_REM1 =
+    "BitBoard::remove(const TilePtr &)";
+inline constexpr std::string_view BITBOARD_REM2 =
+    "BitBoard::remove(const GatePtr &)";
+inline constexpr std::string_view BITBOARD_GETG =
+    "BitBoard::getGate(const TilePtr &, const TilePtr &)";
+inline constexpr std::string_view BITBOARD_ROTT =
+    "BitBoard::rotateTile(const TilePtr &, const Rotation &)";
+inline constexpr std::string_view BITBOARD_SETGACTIVE =
+    "BitBoard::setGateActive(const GatePtr &, bool)";
+inline constexpr std::string_view BITBOARD_MVCSR =
+    "BitBoard::moveCursor(const Direction &)";
+
+// End of pone::BitBoard names
+
+// Start of pone::ColorRegistry names
+
+inline constexpr std::string_view COLOR_NAME =
+    "ColorRegistry::name(const ColorID &)";
+
+// End of pone::ColorRegistry names
+
 // Start of pone::Cursor names
 
 inline constexpr std::string_view CURSOR_CURSOR_1 = "Cursor::Cursor()";
@@ -165,6 +236,10 @@ inline constexpr std::string_view TILE_ISTSWITCH = "Tile::isTileSwitch()";
 inline constexpr std::string_view TILE_ISTYPE =
     "Tile::isType(const std::string &)";
 inline constexpr std::string_view TILE_PRINT = "Tile::print(std::ostream &)";
+inline constexpr std::string_view TILE_TYPENAME =
+    "tileTypeName(const TileType &)";
+inline constexpr std::string_view TILE_TYPEFROMNAME =
+    "tileTypeFromName(const std::string &)";
 
 } // namespace name
 
@@ -1,5 +1,5 @@
 /*  Created:  2024-06-23
- *  Modified: 2026-05-04
+ *  Modified: 2026-10-17
  */
 
 #include "pone_game.hpp"
@@ -25,12 +25,11 @@ void Game::setup(const int &l, const int &w) {
 void Game::moveCursor(const int &d) {
     switch (d) {
     case UP:
-        return;
     case DOWN:
-        return;
     case LEFT:
-        return;
     case RIGHT:
+        // Blocked moves are routine, so they are not errors.
+        board.tryMoveCursor(static_cast<Direction>(d));
         return;
     default:
         // FIXME: Add name to this
@@ -1,9 +1,10 @@
 /*   Created:    2024-06-29
- *   Modified:   2026-05-04
+ *   Modified:   2026-10-17
  */
 
 #include "pone_gate.hpp"
 #include <iostream>
+#include <utility>
 
 namespace pone {
 
@@ -12,13 +13,13 @@ namespace pone {
 // +----------------------------------+
 
 Gate::Gate()
-    : m_name{""}, m_id{-1}, m_tp{TilePair{nullptr, nullptr}}, m_color{"none"},
-      m_active{false} {}
+    : m_name{""}, m_id{-1}, m_tp{TilePair{nullptr, nullptr}},
+      m_color{NO_COLOR}, m_active{false} {}
 
 Gate::Gate(TilePtr t1, TilePtr t2, const std::string &name,
            const std::string &color, bool active)
-    : m_name{name}, m_id{-1}, m_tp{TilePair{t1, t2}}, m_color{color},
-      m_active{active} {}
+    : m_name{name}, m_id{-1}, m_tp{TilePair{t1, t2}},
+      m_color{ColorRegistry::intern(color)}, m_active{active} {}
 
 Gate::Gate(const Gate &other)
     : m_name{other.m_name}, m_id{other.m_id}, m_tp{other.m_tp},
@@ -45,28 +46,28 @@ Gate &Gate::operator=(const Gate &other) {
 // + Gate getters/setters             +
 // +----------------------------------+
 
-TilePtr Gate::getTile1() const {
+const TilePtr &Gate::getTile1() const {
     return m_tp.first;
 }
 
 void Gate::setTile1(TilePtr t1) {
-    m_tp.first = t1;
+    m_tp.first = std::move(t1);
 }
 
-TilePtr Gate::getTile2() const {
+const TilePtr &Gate::getTile2() const {
     return m_tp.second;
 }
 
 void Gate::setTile2(TilePtr t2) {
-    m_tp.second = t2;
+    m_tp.second = std::move(t2);
 }
 
-TilePair Gate::getTilePair() const {
+const TilePair &Gate::getTilePair() const {
     return m_tp;
 }
 
 void Gate::setTilePair(TilePair tp) {
-    m_tp = tp;
+    m_tp = std::move(tp);
 }
 
 int Gate::getID() const {
@@ -78,10 +79,18 @@ void Gate::setID(int id) {
 }
 
 std::string Gate::getColor() const {
-    return m_color;
+    return ColorRegistry::name(m_color);
 }
 
 void Gate::setColor(const std::string &color) {
+    m_color = ColorRegistry::intern(color);
+}
+
+ColorID Gate::getColorID() const {
+    return m_color;
+}
+
+void Gate::setColorID(const ColorID &color) {
     m_color = color;
 }
 
@@ -105,7 +114,7 @@ void Gate::setActive() {
 // + Gate operations                  +
 // +----------------------------------+
 
-bool Gate::isActive() {
+bool Gate::isActive() const {
     return m_active;
 }
 
@@ -113,7 +122,8 @@ void Gate::print(std::ostream &out) const {
     TilePtr t1 = m_tp.first, t2 = m_tp.second;
     out << "{name: " << m_name << ", id: " << m_id << ", t1: {" << t1->getX()
         << ", " << t1->getY() << "}, t2: {" << t2->getX() << ", " << t2->getY()
-        << "}, color: " << m_color << "}" << std::endl;
+        << "}, color: " << ColorRegistry::name(m_color) << "}"
+        << std::endl;
 }
 
 std::ostream &operator<<(std::ostream &out, const Gate &g) {
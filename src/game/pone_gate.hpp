@@ -1,5 +1,5 @@
 #/*   Created:    2024-06-29
-  *   Modified:   2026-05-04
+  *   Modified:   2026-10-17
   */
 
 #pragma once
@@ -21,7 +21,7 @@ class Gate {
     std::string m_name;
     int m_id;
     TilePair m_tp; // Is a gate between two adjacent tiles.
-    std::string m_color;
+    ColorID m_color;
     bool m_active; // Is the gate on or off?
   public:
     // +----------------------------------+
@@ -43,18 +43,23 @@ class Gate {
     // + Gate getters/setters             +
     // +----------------------------------+
 
-    TilePtr getTile1() const;
+    // The tile getters return references, so reading a gate's tiles
+    // does not touch their reference counts.
+    const TilePtr &getTile1() const;
     void setTile1(TilePtr t1);
 
-    TilePtr getTile2() const;
+    const TilePtr &getTile2() const;
     void setTile2(TilePtr t2);
 
-    TilePair getTilePair() const;
+    const TilePair &getTilePair() const;
     void setTilePair(TilePair tp);
 
     std::string getColor() const;
     void setColor(const std::string &color);
 
+    ColorID getColorID() const;
+    void setColorID(const ColorID &color);
+
     int getID() const;
     void setID(int id);
 
@@ -68,7 +73,7 @@ class Gate {
     // + Gate functions                   +
     // +----------------------------------+
 
-    bool isActive();
+    bool isActive() const;
     void print(std::ostream &out) const;
     friend std::ostream &operator<<(std::ostream &out, const Gate &g);
 
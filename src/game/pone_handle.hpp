@@ -0,0 +1,123 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <limits>
+
+namespace pone {
+
+class Tile;
+class Gate;
+
+/**
+ * A 64-bit generational handle to a tile or gate on a board.
+ *
+ * The low INDEX_BITS bits hold the index of a board slot (a cell for
+ * tiles, an edge for gates), and the remaining 32 bits its generation.
+ * A board bumps the generation of a slot whenever it empties the
+ * slot, so a handle to a removed object goes stale instead of keeping
+ * the object alive.
+ *
+ * @note Generations wrap around after 2^32 removals from the same
+ *       slot; only then could a stale handle match a new object.
+ * @note Handles are 64-bit, not 32-bit: the sparse grid numbers cells
+ *       up to INT_MAX, which leaves no room for a generation in 32
+ *       bits, and a few generation bits wrap around within one game.
+ * @note A handle only names a slot. The slot itself still holds a
+ *       shared_ptr, which snapshots and the journal share, so a
+ *       handle does not replace TilePtr or GatePtr as the owner.
+ *
+ * @tparam T the type of the object, Tile or Gate.
+ */
+template <typename T> class Handle {
+    // +----------------------------------+
+    // + Handle data members              +
+    // +----------------------------------+
+
+    std::uint64_t m_value;
+
+  public:
+    static constexpr int INDEX_BITS = 32;
+    static constexpr std::uint64_t INDEX_MASK = (1ull << INDEX_BITS) - 1;
+    static constexpr std::uint32_t GENERATION_MASK = ~0u;
+
+    /**
+     * The largest slot index a handle can hold.
+     */
+    static constexpr int MAX_INDEX = std::numeric_limits<int>::max();
+
+    // +----------------------------------+
+    // + Handle constructors              +
+    // +----------------------------------+
+
+    /**
+     * Constructs a null handle.
+     */
+    constexpr Handle() : m_value{~0ull} {}
+
+    /**
+     * Constructs a handle to a slot.
+     *
+     * @param index the slot index, at most MAX_INDEX.
+     * @param generation the generation of the slot.
+     */
+    constexpr Handle(const int &index, const std::uint32_t &generation)
+        : m_value{(static_cast<std::uint64_t>(generation) << INDEX_BITS) |
+                  static_cast<std::uint32_t>(index)} {}
+
+    // +----------------------------------+
+    // + Handle getters                   +
+    // +----------------------------------+
+
+    /**
+     * Gets the slot index of the handle.
+     *
+     * @return the index.
+     */
+    constexpr int index() const {
+        return static_cast<int>(m_value & INDEX_MASK);
+    }
+
+    /**
+     * Gets the generation of the handle.
+     *
+     * @return the generation.
+     */
+    constexpr std::uint32_t generation() const {
+        return static_cast<std::uint32_t>(m_value >> INDEX_BITS);
+    }
+
+    /**
+     * Checks if the handle is null.
+     *
+     * @return true if the handle refers to no slot, otherwise false.
+     */
+    constexpr bool isNull() const { return m_value == ~0ull; }
+
+    /**
+     * Gets the packed value of the handle.
+     *
+     * @return the 64-bit value.
+     */
+    constexpr std::uint64_t value() const { return m_value; }
+
+    constexpr auto operator<=>(const Handle &other) const = default;
+};
+
+/**
+ * A handle to a tile on a board.
+ */
+using TileHandle = Handle<Tile>;
+
+/**
+ * A handle to a gate on a board.
+ */
+using GateHandle = Handle<Gate>;
+
+static_assert(sizeof(TileHandle) == 8);
+
+} // namespace pone
@@ -0,0 +1,69 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+#include "pone_publisher.hpp"
+
+namespace pone {
+
+// +----------------------------------+
+// + BoardPublisher constructors      +
+// +----------------------------------+
+
+BoardPublisher::BoardPublisher() : BoardPublisher(Board{}) {}
+
+BoardPublisher::BoardPublisher(const Board &board)
+    : m_view{std::make_shared<const Board>(board.snapshot())},
+      m_publishes{1} {}
+
+// +----------------------------------+
+// + BoardPublisher functions         +
+// +----------------------------------+
+
+BoardView BoardPublisher::publish(const Board &board) {
+    // The snapshot is built before it is stored, so readers only ever
+    // see complete boards. Release publishes its contents with it.
+    BoardView view = std::make_shared<const Board>(board.snapshot());
+    m_view.store(view, std::memory_order_release);
+    m_publishes.fetch_add(1, std::memory_order_release);
+    return view;
+}
+
+BoardView BoardPublisher::read() const {
+    return m_view.load(std::memory_order_acquire);
+}
+
+std::uint64_t BoardPublisher::publishes() const {
+    return m_publishes.load(std::memory_order_acquire);
+}
+
+// +----------------------------------+
+// + BoardReader constructors         +
+// +----------------------------------+
+
+BoardReader::BoardReader(const BoardPublisher &publisher)
+    : m_publisher{&publisher}, m_seen{publisher.publishes()} {
+    m_view = publisher.read();
+}
+
+// +----------------------------------+
+// + BoardReader functions            +
+// +----------------------------------+
+
+const Board &BoardReader::current() {
+    // publish stores the view before counting it, so the view read
+    // after seeing a count is at least that new.
+    std::uint64_t count = m_publisher->publishes();
+    if (count != m_seen) {
+        m_seen = count;
+        m_view = m_publisher->read();
+    }
+
+    return *m_view;
+}
+
+const BoardView &BoardReader::view() const {
+    return m_view;
+}
+
+} // namespace pone
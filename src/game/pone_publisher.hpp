@@ -0,0 +1,152 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+#pragma once
+
+#include "pone_board.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace pone {
+
+/**
+ * A read-only version of a board, shared between threads.
+ */
+using BoardView = std::shared_ptr<const Board>;
+
+/**
+ * Shares a board between one writer thread and any number of reader
+ * threads, read-copy-update style.
+ *
+ * The writer keeps editing its own Board and calls publish whenever
+ * readers should see the changes. Publishing stores a snapshot of the
+ * board, which shares every unchanged chunk, tile and gate with it.
+ * Readers call read to get the latest published view and may query
+ * it for as long as they hold it: a published board is never changed
+ * again, and it is freed when the last reader lets go of it.
+ *
+ * Readers never wait for the writer or for each other on board data,
+ * and the writer never waits for readers. A reader thread that queries
+ * the board many times per publish should go through a BoardReader,
+ * which only touches shared state when a new board was published.
+ *
+ * @note Only the const functions of a view may be called. Copying a
+ *       view into a Board is allowed, and gives the reader a private
+ *       branch to edit.
+ */
+class BoardPublisher {
+    // +----------------------------------+
+    // + BoardPublisher data members      +
+    // +----------------------------------+
+
+    std::atomic<BoardView> m_view;
+    std::atomic<std::uint64_t> m_publishes;
+
+  public:
+    // +----------------------------------+
+    // + BoardPublisher constructors      +
+    // +----------------------------------+
+
+    /**
+     * Constructs a publisher of an empty board.
+     */
+    BoardPublisher();
+
+    /**
+     * Constructs a publisher and publishes a board.
+     *
+     * @param board the first board to publish.
+     */
+    explicit BoardPublisher(const Board &board);
+
+    BoardPublisher(const BoardPublisher &other) = delete;
+    BoardPublisher &operator=(const BoardPublisher &other) = delete;
+
+    // +----------------------------------+
+    // + BoardPublisher functions         +
+    // +----------------------------------+
+
+    /**
+     * Publishes a snapshot of a board. Readers that call read after
+     * this returns see the snapshot; views they already hold are left
+     * as they are.
+     *
+     * @note Only one thread may publish at a time. It should be the
+     *       thread that edits the board.
+     * @param board the board to publish.
+     * @return the published view.
+     */
+    BoardView publish(const Board &board);
+
+    /**
+     * Gets the most recently published view.
+     *
+     * @return the view, never null.
+     */
+    BoardView read() const;
+
+    /**
+     * Gets the number of boards published so far, so that a reader can
+     * tell cheaply whether read would return a newer view.
+     *
+     * @return the number of calls to publish, counting the
+     *         constructor.
+     */
+    std::uint64_t publishes() const;
+};
+
+/**
+ * A reader thread's cached view of a BoardPublisher.
+ *
+ * Between two publishes, getting the board costs one atomic load of
+ * the publish count, which does not write to memory shared with other
+ * readers, so readers on different cores do not slow each other down.
+ *
+ * @note A BoardReader belongs to one thread.
+ */
+class BoardReader {
+    // +----------------------------------+
+    // + BoardReader data members         +
+    // +----------------------------------+
+
+    const BoardPublisher *m_publisher;
+    BoardView m_view;
+    std::uint64_t m_seen;
+
+  public:
+    // +----------------------------------+
+    // + BoardReader constructors         +
+    // +----------------------------------+
+
+    /**
+     * Constructs a reader of a publisher.
+     *
+     * @param publisher the publisher, which must outlive the reader.
+     */
+    explicit BoardReader(const BoardPublisher &publisher);
+
+    // +----------------------------------+
+    // + BoardReader functions            +
+    // +----------------------------------+
+
+    /**
+     * Gets the most recently published board, fetching it from the
+     * publisher only if it changed since the last call.
+     *
+     * @return the board, valid until the next call or until the
+     *         reader is destroyed.
+     */
+    const Board &current();
+
+    /**
+     * Gets the view the reader holds, without checking for a newer
+     * one.
+     *
+     * @return the view.
+     */
+    const BoardView &view() const;
+};
+
+} // namespace pone
@@ -1,21 +1,62 @@
 /*  Created:    2024-06-23
- *  Modified:   2026-05-04
+ *  Modified:   2026-10-17
  */
 
 #include "pone_tile.hpp"
+#include "pone_except.hpp"
+#include <format>
 #include <iostream>
 
 namespace pone {
 
+// Tile type conversion
+// ---------------------------------------------
+std::string_view tileTypeName(const TileType &type) {
+    auto i = static_cast<std::size_t>(type);
+
+    if (i >= TILE_TYPES.size()) {
+        ErrorMessage INVAL_TYPE{name::PONE_GLOBAL_NAME, name::TILE_TYPENAME,
+                                "Invalid tile type."};
+        throw InvalidValueException(INVAL_TYPE);
+    }
+
+    return TILE_TYPES[i].name;
+}
+
+bool findTileType(const std::string &name, TileType &type) {
+    for (const TileTypeInfo &info : TILE_TYPES) {
+        if (info.name == name) {
+            type = info.type;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+TileType tileTypeFromName(const std::string &name) {
+    TileType type;
+
+    if (!findTileType(name, type)) {
+        ErrorMessage INVAL_TYPE{
+            name::PONE_GLOBAL_NAME, name::TILE_TYPEFROMNAME,
+            std::format("\"{}\" is not a tile type.", name)};
+        throw InvalidValueException(INVAL_TYPE);
+    }
+
+    return type;
+}
+
 // Tile constructors
 // ---------------------------------------------
 Tile::Tile()
-    : m_name{""}, m_id{0}, m_x{0}, m_y{0}, m_color{"none"}, m_type{"empty"},
-      m_cursor{false} {}
+    : m_name{""}, m_id{0}, m_x{0}, m_y{0}, m_color{NO_COLOR},
+      m_type{TileType::EMPTY}, m_cursor{false} {}
 
 Tile::Tile(const std::string &name, const int &id, const int &x, const int &y,
            const std::string &color, const std::string &type, bool cursor)
-    : m_name{name}, m_id{id}, m_x{x}, m_y{y}, m_color{color}, m_type{type},
+    : m_name{name}, m_id{id}, m_x{x}, m_y{y},
+      m_color{ColorRegistry::intern(color)}, m_type{tileTypeFromName(type)},
       m_cursor{cursor} {}
 
 Tile::Tile(const Tile &other)
@@ -58,18 +99,34 @@ CoordPair Tile::getCoordPair() const {
 }
 
 std::string Tile::getColor() const {
-    return m_color;
+    return ColorRegistry::name(m_color);
 }
 
 void Tile::setColor(const std::string &color) {
+    m_color = ColorRegistry::intern(color);
+}
+
+ColorID Tile::getColorID() const {
+    return m_color;
+}
+
+void Tile::setColorID(const ColorID &color) {
     m_color = color;
 }
 
 std::string Tile::getType() const {
-    return m_type;
+    return std::string{tileTypeName(m_type)};
 }
 
 void Tile::setType(const std::string &type) {
+    m_type = tileTypeFromName(type);
+}
+
+TileType Tile::getTileType() const {
+    return m_type;
+}
+
+void Tile::setTileType(const TileType &type) {
     m_type = type;
 }
 
@@ -96,7 +153,7 @@ void Tile::setName(const std::string &name) {
 // Tile functions
 // ---------------------------------------------
 bool Tile::isCollision() const {
-    return m_type == "collision";
+    return m_type == TileType::COLLISION;
 }
 
 bool Tile::isCursor() const {
@@ -104,34 +161,35 @@ bool Tile::isCursor() const {
 }
 
 bool Tile::isDirection() const {
-    return m_type == "left" || m_type == "right" || m_type == "up" ||
-           m_type == "down";
+    return TILE_TYPES[static_cast<std::size_t>(m_type)].direction;
 }
 
 bool Tile::isEmpty() const {
-    return m_type == "empty";
+    return m_type == TileType::EMPTY;
 }
 
 bool Tile::isGateSwitch() const {
-    return m_type == "gswitch";
+    return m_type == TileType::GATE_SWITCH;
 }
 
 bool Tile::isGoal() const {
-    return m_type == "goal";
+    return m_type == TileType::GOAL;
 }
 
 bool Tile::isTileSwitch() const {
-    return m_type == "tswitch";
+    return m_type == TileType::TILE_SWITCH;
 }
 
 bool Tile::isType(const std::string &type) const {
-    return m_type == type;
+    TileType t;
+    return findTileType(type, t) && m_type == t;
 }
 
 void Tile::print(std::ostream &out) const {
     out << "{name: " << m_name << ", id: " << m_id << ", x: " << m_x
-        << ", y: " << m_y << ", color: " << m_color << ", type: " << m_type
-        << ", cursor: " << m_cursor << "}";
+        << ", y: " << m_y << ", color: " << ColorRegistry::name(m_color)
+        << ", type: " << tileTypeName(m_type) << ", cursor: " << m_cursor
+        << "}";
 }
 
 std::ostream &operator<<(std::ostream &out, const Tile &t) {
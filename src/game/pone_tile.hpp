@@ -1,16 +1,82 @@
 /*  Created:    2024-06-23
- *  Modified:   2026-05-04
+ *  Modified:   2026-10-17
  */
 
 #pragma once
 
+#include "pone_color.hpp"
+#include "pone_const.hpp"
+#include <array>
 #include <string>
-#include <vector>
+#include <string_view>
 
 namespace pone {
 
 using CoordPair = std::pair<int, int>;
 
+/**
+ * Static description of a tile type.
+ */
+struct TileTypeInfo {
+    TileType type;
+    std::string_view name;
+    bool direction; // Can the tile be rotated?
+};
+
+/**
+ * Catalog of every tile type, indexed by TileType.
+ */
+inline constexpr std::array<TileTypeInfo, 10> TILE_TYPES = {{
+    {TileType::EMPTY, "empty", false},
+    {TileType::GATE_SWITCH, "gswitch", false},
+    {TileType::TILE_SWITCH, "tswitch", false},
+    {TileType::KEY, "key", false},
+    {TileType::UP, "up", true},
+    {TileType::DOWN, "down", true},
+    {TileType::LEFT, "left", true},
+    {TileType::RIGHT, "right", true},
+    {TileType::GOAL, "goal", false},
+    {TileType::COLLISION, "collision", false},
+}};
+
+static_assert(
+    [] {
+        for (std::size_t i = 0; i < TILE_TYPES.size(); ++i)
+            if (static_cast<std::size_t>(TILE_TYPES[i].type) != i)
+                return false;
+        return true;
+    }(),
+    "TILE_TYPES must be indexed by TileType.");
+
+/**
+ * Gets the name of a tile type.
+ *
+ * @param type the tile type.
+ *
+ * @return the name of the type, e.g. "gswitch".
+ */
+std::string_view tileTypeName(const TileType &type);
+
+/**
+ * Finds a tile type by name.
+ *
+ * @param name the name of the type.
+ * @param type set to the matching type if it was found.
+ *
+ * @return true if the name is a tile type, otherwise false.
+ */
+bool findTileType(const std::string &name, TileType &type);
+
+/**
+ * Gets a tile type by name.
+ *
+ * @param name the name of the type.
+ *
+ * @return the matching tile type.
+ * @throws InvalidValueException if the name is not a tile type.
+ */
+TileType tileTypeFromName(const std::string &name);
+
 class Tile {
   public:
     // +----------------------------------+
@@ -44,9 +110,15 @@ class Tile {
     std::string getColor() const;
     void setColor(const std::string &color);
 
+    ColorID getColorID() const;
+    void setColorID(const ColorID &color);
+
     std::string getType() const;
     void setType(const std::string &type);
 
+    TileType getTileType() const;
+    void setTileType(const TileType &type);
+
     void setCursor(bool c);
 
     int getID() const;
@@ -95,17 +167,9 @@ class Tile {
     std::string m_name;
     int m_id;     // starting from 1
     int m_x, m_y; // coordinates of the tile
-    std::string m_color;
-    std::string m_type; // what is the type of this tile?
-    bool m_cursor;      // is the cursor on this tile?
-
-    // +----------------------------------+
-    // + Tile constants                   +
-    // +----------------------------------+
-
-    const std::vector<std::string> types = {
-        "empty", "gswitch", "tswitch", "key",  "up",
-        "down",  "left",    "right",   "goal", "collision"};
+    ColorID m_color;
+    TileType m_type; // what is the type of this tile?
+    bool m_cursor;   // is the cursor on this tile?
 };
 
 } // namespace pone
@@ -1,12 +1,19 @@
 /*    Created:    2025-06-30
- *    Modified:   2025-05-04
+ *    Modified:   2026-10-17
  */
 
 #pragma once
 
 #include <algorithm> // std::max
 #include <compare>
+#include <cstddef>
+#include <functional> // std::less
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace pone {
@@ -42,6 +49,204 @@ template <typename T> struct DefaultComparator {
     }
 };
 
+// +--------------------------------+
+// + Node allocators                +
+// +--------------------------------+
+
+/* Node allocation policy that takes every node from the global heap.
+ *
+ * @note A policy hands out uninitialized storage for one Node at a time;
+ *       the tree constructs and destroys the nodes in it. Storage may
+ *       leave one tree and join another: lease gives the Lease that
+ *       keeps a node's storage alive while it is in no tree, adopt
+ *       takes it over into another policy, and release frees it if it
+ *       never joins one.
+ */
+template <typename Node> struct AVLHeapAllocator {
+    /* Heap nodes own their storage, so a lease carries nothing. */
+    struct Lease {};
+
+    /* Allocates storage for one node.
+     *
+     * @return the storage.
+     */
+    void *allocate() { return ::operator new(sizeof(Node)); }
+
+    /* Frees storage from allocate.
+     *
+     * @param node the storage, its node already destroyed.
+     */
+    void deallocate(void *node) { ::operator delete(node); }
+
+    /* Gets the lease of a node leaving the tree.
+     *
+     * @param node the storage of the node.
+     * @return the lease.
+     */
+    Lease lease(void *) const { return {}; }
+
+    /* Takes over the storage of a node joining the tree.
+     *
+     * @param node the storage of the node.
+     * @param lease the lease of the node.
+     */
+    void adopt(void *, Lease &&) {}
+
+    /* Frees the storage of a node that is in no tree.
+     *
+     * @param node the storage, its node already destroyed.
+     * @param lease the lease of the node.
+     */
+    static void release(void *node, Lease &) { ::operator delete(node); }
+};
+
+/* Node allocation policy that carves nodes out of slabs. Freed nodes go
+ * onto a free list and are handed out again before the slabs grow, so a
+ * tree's nodes stay packed together and most inserts do not call malloc.
+ *
+ * @note Slabs double in size from 64 up to 65536 nodes. They are shared:
+ *       a node moved to another tree keeps its storage, and that tree
+ *       keeps the slab it lives in alive, as does a node handle.
+ * @note Pools are not thread-safe, like the trees that own them.
+ */
+template <typename Node> class AVLNodePool {
+    // +--------------------------------+
+    // + AVLNodePool data members       +
+    // +--------------------------------+
+
+    /* Storage for one node, or a link in the free list. */
+    union Slot {
+        Slot *next;
+        alignas(Node) unsigned char bytes[sizeof(Node)];
+    };
+
+    /* A block of slots, shared by every pool that holds nodes in it. */
+    struct Slab {
+        std::shared_ptr<Slot[]> slots;
+        std::size_t size;
+
+        bool contains(const void *node) const {
+            std::less<const void *> before;
+            return !before(node, slots.get()) &&
+                   before(node, slots.get() + size);
+        }
+    };
+
+    /* Everything a pool owns, shared with the leases it gives out. */
+    struct State {
+        std::vector<Slab> slabs;    // carved by this pool, last one in use
+        std::vector<Slab> borrowed; // carved by others, holding our nodes
+        Slot *free = nullptr;       // head of the free list
+        std::size_t next = 0;       // first unused slot of the last slab
+    };
+
+    static constexpr std::size_t FIRST_SLAB = 64;
+    static constexpr std::size_t MAX_SLAB = 65536;
+
+    std::shared_ptr<State> m_state; // nullptr until the first node
+
+    /* Gets the pool state, creating it if needed.
+     *
+     * @return the state.
+     */
+    State &state() {
+        if (m_state == nullptr)
+            m_state = std::make_shared<State>();
+        return *m_state;
+    }
+
+  public:
+    /* Keeps the slab of a node alive while the node is in no tree. */
+    struct Lease {
+        Slab slab;                  // the slab the node lives in
+        std::weak_ptr<State> owner; // the pool it was leased from
+    };
+
+    /* AVLNodePool constructor. Allocates nothing until the first node. */
+    AVLNodePool() = default;
+
+    AVLNodePool(const AVLNodePool &other) = delete;
+    AVLNodePool &operator=(const AVLNodePool &other) = delete;
+
+    /* Allocates storage for one node.
+     *
+     * @return the storage.
+     */
+    void *allocate() {
+        State &pool = state();
+        if (pool.free != nullptr) {
+            Slot *slot = pool.free;
+            pool.free = slot->next;
+            return slot;
+        }
+
+        if (pool.slabs.empty() || pool.next == pool.slabs.back().size) {
+            std::size_t size =
+                pool.slabs.empty()
+                    ? FIRST_SLAB
+                    : std::min(2 * pool.slabs.back().size, MAX_SLAB);
+            pool.slabs.push_back({std::shared_ptr<Slot[]>{new Slot[size]},
+                                  size});
+            pool.next = 0;
+        }
+        return &pool.slabs.back().slots[pool.next++];
+    }
+
+    /* Puts storage from allocate, or adopted storage, onto the free list.
+     *
+     * @param node the storage, its node already destroyed.
+     */
+    void deallocate(void *node) {
+        Slot *slot = static_cast<Slot *>(node);
+        slot->next = m_state->free;
+        m_state->free = slot;
+    }
+
+    /* Gets the lease of a node leaving the tree.
+     *
+     * @param node the storage of the node.
+     * @return the lease.
+     */
+    Lease lease(void *node) const {
+        for (const std::vector<Slab> *slabs :
+             {&m_state->slabs, &m_state->borrowed})
+            for (const Slab &slab : *slabs)
+                if (slab.contains(node))
+                    return {slab, m_state};
+        return {};
+    }
+
+    /* Takes over the storage of a node joining the tree. Storage from
+     * another pool keeps its slab alive for as long as this pool lives.
+     *
+     * @param node the storage of the node.
+     * @param lease the lease of the node.
+     */
+    void adopt(void *node, Lease &&lease) {
+        State &pool = state();
+        for (const std::vector<Slab> *slabs : {&pool.slabs, &pool.borrowed})
+            for (const Slab &slab : *slabs)
+                if (slab.contains(node))
+                    return;
+        pool.borrowed.push_back(std::move(lease.slab));
+    }
+
+    /* Frees the storage of a node that is in no tree, onto the free
+     * list of the pool it was leased from if that pool still exists.
+     *
+     * @param node the storage, its node already destroyed.
+     * @param lease the lease of the node.
+     */
+    static void release(void *node, Lease &lease) {
+        if (std::shared_ptr<State> owner = lease.owner.lock()) {
+            Slot *slot = static_cast<Slot *>(node);
+            slot->next = owner->free;
+            owner->free = slot;
+        }
+        lease = {};
+    }
+};
+
 /* Implementation of nodes within an AVL tree. */
 template <typename T, typename Compare = DefaultComparator<T>> struct AVLNode {
     // +--------------------------------+
@@ -51,8 +256,12 @@ template <typename T, typename Compare = DefaultComparator<T>> struct AVLNode {
     T data;                // Node data
     AVLNode *left, *right; // Left and right children
     int height;
+    int size;              // # of nodes in the subtree
     static Compare m_compare; // Comparator
 
+    /* An AVL tree of INT_MAX nodes is at most 45 nodes high. */
+    static constexpr int MAX_HEIGHT = 48;
+
     /* AVLNode constructor.
      * Usage: AVLNode<T, Compare> *node = new AVLNode(x);
      *
@@ -61,19 +270,63 @@ template <typename T, typename Compare = DefaultComparator<T>> struct AVLNode {
      */
     AVLNode(const T &key, Compare compare = Compare());
 
+    /* AVLNode constructor that builds its value in place.
+     * Usage: AVLNode<T, Compare> node{std::in_place, args...};
+     *
+     * @param args the arguments of a T constructor.
+     */
+    template <typename... Args>
+    explicit AVLNode(std::in_place_t, Args &&...args);
+
     // +--------------------------------+
     // + AVLNode node operations        +
     // +--------------------------------+
 
-    /* Inserts a node into the AVL subtree.
+    /* Allocates a node and constructs its value in place.
+     *
+     * @param alloc the node allocation policy.
+     * @param args the arguments of a T constructor.
+     * @return the node, not yet in a tree.
+     */
+    template <typename Alloc, typename... Args>
+    static AVLNode *create(Alloc &alloc, Args &&...args);
+
+    /* Destroys and frees a node.
+     *
+     * @param node the node, detached from its tree.
+     * @param alloc the node allocation policy it came from.
+     */
+    template <typename Alloc> static void destroy(AVLNode *node, Alloc &alloc);
+
+    /* Destroys and frees every node of an AVL subtree.
+     *
+     * @param root the root of an AVL subtree.
+     * @param alloc the node allocation policy it came from.
+     */
+    template <typename Alloc>
+    static void destroyAll(AVLNode *root, Alloc &alloc);
+
+    /* Inserts a node into the AVL subtree, without recursion.
      *
+     * @note Equal keys go to the right of each other.
      * @param root the root of an AVL subtree.
      * @param key a value of type T.
+     * @param alloc the node allocation policy.
+     * @return the root.
+     */
+    template <typename Alloc>
+    static AVLNode *insert(AVLNode *root, const T &key, Alloc &alloc);
+
+    /* Links a node into the AVL subtree, without recursion.
+     *
+     * @note Equal keys go to the right of each other.
+     * @param root the root of an AVL subtree.
+     * @param node a node that is in no tree.
      * @return the root.
      */
-    static AVLNode *insert(AVLNode *root, const T &key);
+    static AVLNode *insertNode(AVLNode *root, AVLNode *node);
 
-    /* Finds and returns a node from the AVL subtree.
+    /* Finds and returns a node from the AVL subtree, without recursion.
      *
      * @param root the root of an AVL subtree.
      * @param key a value of type T.
@@ -81,13 +334,26 @@ template <typename T, typename Compare = DefaultComparator<T>> struct AVLNode {
      */
     static AVLNode *find(AVLNode *root, const T &key);
 
-    /* Removes a node from the AVL subtree.
+    /* Removes a node from the AVL subtree, without recursion.
      *
+     * @note If the key cannot be found, the subtree is left as it is.
      * @param root the root of an AVL subtree.
      * @param key a value of type T.
+     * @param alloc the node allocation policy.
      * @return the root.
      */
-    static AVLNode *remove(AVLNode *root, const T &key);
+    template <typename Alloc>
+    static AVLNode *remove(AVLNode *root, const T &key, Alloc &alloc);
+
+    /* Unlinks a node from the AVL subtree without destroying it,
+     * without recursion.
+     *
+     * @param root the root of an AVL subtree, updated in place.
+     * @param key a value of type T.
+     * @return a node holding a value equal to key, no longer in any
+     *         tree, or nullptr if the key cannot be found.
+     */
+    static AVLNode *detach(AVLNode *&root, const T &key);
 
     // +-------------------------------------+
     // + AVLNode tree balancing operations   +
@@ -115,7 +381,8 @@ template <typename T, typename Compare = DefaultComparator<T>> struct AVLNode {
      */
     static AVLNode *rightRotate(AVLNode *y);
 
-    /* Sets the height of an AVLNode.
+    /* Sets the height and the subtree size of an AVLNode
+     * from those of its children.
      *
      * @param root the root of an AVL subtree.
      * @return the height.
@@ -129,6 +396,24 @@ template <typename T, typename Compare = DefaultComparator<T>> struct AVLNode {
      */
     static int getHeight(AVLNode *root);
 
+    /* Gets the # of nodes in an AVL subtree.
+     *
+     * @param root the root of an AVL subtree.
+     * @return the subtree size, 0 for nullptr.
+     */
+    static int getSize(const AVLNode *root);
+
+    /* Counts the values of an AVL subtree that come before a key.
+     *
+     * @param root the root of an AVL subtree.
+     * @param key a value of type T.
+     * @param inclusive true to also count values equal to key.
+     * @return the # of values less than key, or not greater
+     *         than key if inclusive.
+     */
+    static int countBefore(const AVLNode *root, const T &key,
+                           const bool &inclusive);
+
     /* # of children an AVLNode has.
      *
      * @param root the root of an AVL subtree.
@@ -158,6 +443,17 @@ template <typename T, typename Compare = DefaultComparator<T>> struct AVLNode {
      */
     static AVLNode *rebalance(AVLNode *root);
 
+    /* Updates the nodes on a path, bottom-up, after a node was added
+     * or removed below them. Rebalancing stops at the first subtree
+     * whose height did not change, since the balance of the nodes
+     * above it did not change either; those only get their size fixed.
+     *
+     * @param path the links followed from the root, root first.
+     * @param depth the # of links on the path.
+     * @param delta +1 after an insertion, -1 after a removal.
+     */
+    static void retrace(AVLNode **path[], int depth, const int &delta);
+
     /* Finds the successor for an AVLNode.
      *
      * @param target the pivot AVLNode.
@@ -196,6 +492,45 @@ template <typename T, typename Compare = DefaultComparator<T>> struct AVLNode {
      */
     static void postorder(AVLNode *root, std::vector<T> &vec);
 
+    /* Visits the values of the AVL subtree in preorder.
+     *
+     * @param root the root of an AVL subtree.
+     * @param visit a callable taking a const T&. If it returns a
+     *        value, false stops the traversal.
+     * @return false if the traversal was stopped, true otherwise.
+     */
+    template <typename Visit>
+    static bool visitPreorder(const AVLNode *root, Visit &visit);
+
+    /* Visits the values of the AVL subtree in order.
+     *
+     * @param root the root of an AVL subtree.
+     * @param visit a callable taking a const T&. If it returns a
+     *        value, false stops the traversal.
+     * @return false if the traversal was stopped, true otherwise.
+     */
+    template <typename Visit>
+    static bool visitInorder(const AVLNode *root, Visit &visit);
+
+    /* Visits the values of the AVL subtree in postorder.
+     *
+     * @param root the root of an AVL subtree.
+     * @param visit a callable taking a const T&. If it returns a
+     *        value, false stops the traversal.
+     * @return false if the traversal was stopped, true otherwise.
+     */
+    template <typename Visit>
+    static bool visitPostorder(const AVLNode *root, Visit &visit);
+
+    /* Calls a visitor on one value.
+     *
+     * @param visit a callable taking a const T&.
+     * @param value the value to visit.
+     * @return false if the visitor returned false, true otherwise.
+     */
+    template <typename Visit>
+    static bool callVisitor(Visit &visit, const T &value);
+
     /* Prints the preorder traversal of the AVL subtree
      * to the console.
      *
@@ -246,17 +581,224 @@ template <typename T, typename Compare = DefaultComparator<T>> struct AVLNode {
     static bool greater(const T &lhs, const T &rhs);
 };
 
-/* Implementation of AVL trees. */
-template <typename T, typename Compare = DefaultComparator<T>> class AVL {
+template <typename T, typename Compare, template <typename> class Alloc>
+class AVL;
+
+/* Bidirectional iterator over the values of an AVL tree, in order,
+ * or in reverse order if REVERSE is true.
+ *
+ * @note AVLNodes do not point to their parents, so the iterator keeps
+ *       the path from the root down to its node, in place. Moving it
+ *       never allocates and takes amortized constant time.
+ * @note Inserting into or removing from the tree invalidates every
+ *       iterator of the tree.
+ */
+template <typename T, typename Compare = DefaultComparator<T>,
+          bool REVERSE = false>
+class AVLIterator {
+    // +--------------------------------+
+    // + AVLIterator data members       +
+    // +--------------------------------+
+
+    using Node = AVLNode<T, Compare>;
+
+    const Node *m_root;                   // root of the tree
+    const Node *m_path[Node::MAX_HEIGHT]; // root to current node
+    int m_depth;                          // 0 at the end
+
+    template <typename, typename, template <typename> class>
+    friend class AVL;
+
+    /* Constructs an iterator at the end of a tree.
+     *
+     * @param root the root of the tree.
+     */
+    explicit AVLIterator(const Node *root);
+
+    /* Gets the left or right child of a node.
+     *
+     * @param node the parent node.
+     * @param right true for the right child, false for the left.
+     * @return the child.
+     */
+    static const Node *child(const Node *node, const bool &right);
+
+    /* Moves down from a node to the leftmost or rightmost node of its
+     * subtree.
+     *
+     * @param node the node to push onto the path.
+     * @param right true to follow right children, false for left.
+     */
+    void descend(const Node *node, const bool &right);
+
+    /* Moves to the next node in order, or to the previous one. From the
+     * end, moves to the first or the last node.
+     *
+     * @param right true for the next node, false for the previous.
+     */
+    void step(const bool &right);
+
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    // +--------------------------------+
+    // + AVLIterator constructors       +
+    // +--------------------------------+
+
+    /* Constructs an iterator that belongs to no tree. */
+    AVLIterator();
+
+    /* AVLIterator copy constructor. Only copies the used path.
+     *
+     * @param other the iterator to copy from.
+     */
+    AVLIterator(const AVLIterator &other);
+
+    /* AVLIterator copy assignment. Only copies the used path.
+     *
+     * @param other the iterator to copy from.
+     */
+    AVLIterator &operator=(const AVLIterator &other);
+
+    // +--------------------------------+
+    // + AVLIterator operators          +
+    // +--------------------------------+
+
+    reference operator*() const;
+    pointer operator->() const;
+    AVLIterator &operator++();
+    AVLIterator operator++(int);
+    AVLIterator &operator--();
+    AVLIterator operator--(int);
+
+    /* Equal-to comparison for two AVLIterators of the same tree.
+     *
+     * @param lhs the left-hand field.
+     * @param rhs the right-hand field.
+     * @return true if both point to the same node or both are at the
+     *         end, false otherwise.
+     */
+    friend bool operator==(const AVLIterator &lhs, const AVLIterator &rhs) {
+        return lhs.node() == rhs.node();
+    }
+
+    /* Gets the node the iterator points to.
+     *
+     * @return the node, or nullptr at the end.
+     */
+    const Node *node() const;
+};
+
+/* Owns a node extracted from an AVL tree, like the node handles of
+ * std::map. The node keeps its storage while it moves between trees,
+ * and the handle may outlive the tree it came from.
+ */
+template <typename T, typename Compare, template <typename> class Alloc>
+class AVLNodeHandle {
+    // +--------------------------------+
+    // + AVLNodeHandle data members     +
+    // +--------------------------------+
+
+    using Node = AVLNode<T, Compare>;
+
+    using Lease = typename Alloc<Node>::Lease;
+
+    Node *m_node;  // the node, nullptr if empty
+    Lease m_lease; // keeps the node's storage alive
+
+    friend class AVL<T, Compare, Alloc>;
+
+    /* Constructs a handle that owns a node.
+     *
+     * @param node the node, in no tree, or nullptr.
+     * @param lease the lease of the node's storage.
+     */
+    AVLNodeHandle(Node *node, Lease &&lease);
+
+    /* Destroys the node, if any, and releases its storage. */
+    void reset();
+
+  public:
+    // +--------------------------------+
+    // + AVLNodeHandle constructors     +
+    // +--------------------------------+
+
+    /* Constructs an empty handle. */
+    AVLNodeHandle();
+
+    /* AVLNodeHandle move constructor. Leaves other empty.
+     *
+     * @param other the handle to move from.
+     */
+    AVLNodeHandle(AVLNodeHandle &&other) noexcept;
+
+    /* AVLNodeHandle move assignment. Destroys the node this owned and
+     * leaves other empty.
+     *
+     * @param other the handle to move from.
+     */
+    AVLNodeHandle &operator=(AVLNodeHandle &&other) noexcept;
+
+    AVLNodeHandle(const AVLNodeHandle &other) = delete;
+    AVLNodeHandle &operator=(const AVLNodeHandle &other) = delete;
+
+    /* AVLNodeHandle destructor. Destroys the node, if any. */
+    ~AVLNodeHandle();
+
+    // +--------------------------------+
+    // + AVLNodeHandle functions        +
+    // +--------------------------------+
+
+    /* Checks if the handle owns no node.
+     *
+     * @return true if empty, false otherwise.
+     */
+    bool empty() const;
+
+    /* Checks if the handle owns a node.
+     *
+     * @return true if not empty, false otherwise.
+     */
+    explicit operator bool() const;
+
+    /* Gets the value of the node. It may be changed, or moved from,
+     * before the node is inserted again.
+     *
+     * @note The handle must not be empty.
+     * @return the value.
+     */
+    T &value() const;
+};
+
+/* Implementation of AVL trees.
+ *
+ * @note Alloc is the node allocation policy, AVLNodePool by default.
+ *       Use AVLHeapAllocator to allocate each node on its own.
+ */
+template <typename T, typename Compare = DefaultComparator<T>,
+          template <typename> class Alloc = AVLNodePool>
+class AVL {
     // +--------------------------------+
     // + AVL data members               +
     // +--------------------------------+
 
-    AVLNode<T, Compare> *root; // root of the AVL tree
-    Compare m_compare;         // comparator function
-    int m_size;
+    AVLNode<T, Compare> *root;          // root of the AVL tree
+    Compare m_compare;                  // comparator function
+    Alloc<AVLNode<T, Compare>> m_alloc; // node allocation policy
 
   public:
+    using value_type = T;
+    using size_type = int;
+    using const_iterator = AVLIterator<T, Compare>;
+    using iterator = const_iterator; // values are keys, never mutable
+    using const_reverse_iterator = AVLIterator<T, Compare, true>;
+    using reverse_iterator = const_reverse_iterator;
+    using node_type = AVLNodeHandle<T, Compare, Alloc>;
+
     // +-----------------------------------+
     // + AVL constructors and assignment   +
     // +-----------------------------------+
@@ -289,6 +831,36 @@ template <typename T, typename Compare = DefaultComparator<T>> class AVL {
      */
     void insert(const T &key);
 
+    /* Inserts a node into the AVL tree, moving the value into it.
+     *
+     * @param key the value of the node.
+     */
+    void insert(T &&key);
+
+    /* Inserts a node into the AVL tree, constructing its value in
+     * place.
+     * Usage: tree.emplace(name, x, y);
+     *
+     * @param args the arguments of a T constructor.
+     */
+    template <typename... Args> void emplace(Args &&...args);
+
+    /* Inserts a node extracted from an AVL tree of the same type.
+     *
+     * @note The node itself is linked in; neither it nor its value is
+     *       copied or reallocated. Does nothing if the handle is empty.
+     * @param node the handle, left empty.
+     */
+    void insert(node_type &&node);
+
+    /* Removes a node from the AVL tree without destroying it.
+     *
+     * @param key the value of the node.
+     * @return a handle owning the node, empty if the key
+     *         cannot be found.
+     */
+    node_type extract(const T &key);
+
     /* Finds a node from the AVL tree.
      *
      * @param key the value of the node.
@@ -308,27 +880,127 @@ template <typename T, typename Compare = DefaultComparator<T>> class AVL {
     /* Removes every node from the AVL tree. */
     void removeAll();
 
+    // +--------------------------------+
+    // + AVL iterators                  +
+    // +--------------------------------+
+
+    /* Gets an iterator to the smallest value.
+     *
+     * @return the iterator, equal to end() if the tree is empty.
+     */
+    const_iterator begin() const;
+
+    /* Gets the iterator past the largest value.
+     *
+     * @return the iterator.
+     */
+    const_iterator end() const;
+
+    /* Gets a reverse iterator to the largest value.
+     *
+     * @return the iterator, equal to rend() if the tree is empty.
+     */
+    const_reverse_iterator rbegin() const;
+
+    /* Gets the reverse iterator past the smallest value.
+     *
+     * @return the iterator.
+     */
+    const_reverse_iterator rend() const;
+
+    // +--------------------------------+
+    // + AVL order statistics           +
+    // +--------------------------------+
+
+    /* Gets the value at a position in order, in O(log n).
+     * Usage: for (auto it = tree.select(page * n); ...; ++it)
+     *
+     * @param k the 0-based position.
+     * @return an iterator to the k-th smallest value,
+     *         end() if k is out of range.
+     */
+    const_iterator select(const int &k) const;
+
+    /* Gets the position a key has, or would have, in order,
+     * in O(log n).
+     *
+     * @param key a value of type T.
+     * @return the # of values less than key.
+     */
+    int rank(const T &key) const;
+
+    /* Counts the values within a range, in O(log n).
+     *
+     * @param lo the smallest value to count.
+     * @param hi the largest value to count.
+     * @return the # of values x with lo <= x <= hi,
+     *         0 if hi < lo.
+     */
+    int countInRange(const T &lo, const T &hi) const;
+
+    /* Finds the first value not less than a key, in O(log n).
+     *
+     * @param key a value of type T.
+     * @return an iterator to the value, end() if there is none.
+     */
+    const_iterator lowerBound(const T &key) const;
+
+    /* Finds the first value greater than a key, in O(log n).
+     *
+     * @param key a value of type T.
+     * @return an iterator to the value, end() if there is none.
+     */
+    const_iterator upperBound(const T &key) const;
+
     // +--------------------------------+
     // + AVL traversal functions        +
     // +--------------------------------+
 
+    /* Visits every value in order without allocating.
+     * Usage: tree.forEach([&](const T &x) { return x < limit; });
+     *
+     * @param visit a callable taking a const T&. If it returns a
+     *        value, false stops the traversal.
+     * @return false if the traversal was stopped, true otherwise.
+     */
+    template <typename Visit> bool forEach(Visit &&visit) const;
+
+    /* Visits every value in preorder without allocating.
+     *
+     * @param visit a callable taking a const T&. If it returns a
+     *        value, false stops the traversal.
+     * @return false if the traversal was stopped, true otherwise.
+     */
+    template <typename Visit> bool forEachPreorder(Visit &&visit) const;
+
+    /* Visits every value in postorder without allocating.
+     *
+     * @param visit a callable taking a const T&. If it returns a
+     *        value, false stops the traversal.
+     * @return false if the traversal was stopped, true otherwise.
+     */
+    template <typename Visit> bool forEachPostorder(Visit &&visit) const;
+
     /* Gets the preorder traversal of an AVL tree.
      *
+     * @note Prefer forEachPreorder, which does not copy the values.
      * @return a vector containing node values.
      */
-    std::vector<T> preorder();
+    std::vector<T> preorder() const;
 
-    /* Gets the preorder traversal of an AVL tree.
+    /* Gets the inorder traversal of an AVL tree.
      *
+     * @note Prefer iterating or forEach, which do not copy the values.
      * @return a vector containing node values.
      */
-    std::vector<T> inorder();
+    std::vector<T> inorder() const;
 
     /* Gets the postorder traversal of an AVL tree.
      *
+     * @note Prefer forEachPostorder, which does not copy the values.
      * @return a vector containing node values.
      */
-    std::vector<T> postorder();
+    std::vector<T> postorder() const;
 
     /* Prints the preorder traversal of an AVL tree to the console.
      *
@@ -358,7 +1030,7 @@ template <typename T, typename Compare = DefaultComparator<T>> class AVL {
      */
     bool empty() const;
 
-    /* Gets the number of nodes in the AVL tree.
+    /* Gets the number of nodes in the AVL tree, in O(1).
      *
      * @return an int.
      */
@@ -377,70 +1049,132 @@ template <typename T, typename Compare> Compare AVLNode<T, Compare>::m_compare;
 
 template <typename T, typename Compare>
 AVLNode<T, Compare>::AVLNode(const T &key, Compare compare)
-    : data{key}, left{nullptr}, right{nullptr}, height{0} {
+    : data{key}, left{nullptr}, right{nullptr}, height{1}, size{1} {
     m_compare = compare;
 }
 
 template <typename T, typename Compare>
-AVLNode<T, Compare> *AVLNode<T, Compare>::insert(AVLNode *root, const T &key) {
-    if (root == nullptr)
-        return new AVLNode<T, Compare>{key};
+template <typename... Args>
+AVLNode<T, Compare>::AVLNode(std::in_place_t, Args &&...args)
+    : data(std::forward<Args>(args)...), left{nullptr}, right{nullptr},
+      height{1}, size{1} {}
 
-    if (less(key, root->data)) {
-        root->left = insert(root->left, key);
-    } else
-        root->right = insert(root->right, key);
+template <typename T, typename Compare>
+template <typename Alloc, typename... Args>
+AVLNode<T, Compare> *AVLNode<T, Compare>::create(Alloc &alloc,
+                                                 Args &&...args) {
+    void *storage = alloc.allocate();
+    try {
+        return new (storage)
+            AVLNode<T, Compare>{std::in_place, std::forward<Args>(args)...};
+    } catch (...) {
+        alloc.deallocate(storage);
+        throw;
+    }
+}
 
-    setHeight(root);
-    return rebalance(root);
+template <typename T, typename Compare>
+template <typename Alloc>
+void AVLNode<T, Compare>::destroy(AVLNode *node, Alloc &alloc) {
+    node->~AVLNode();
+    alloc.deallocate(node);
 }
 
 template <typename T, typename Compare>
-AVLNode<T, Compare> *AVLNode<T, Compare>::find(AVLNode<T, Compare> *root,
-                                               const T &key) {
+template <typename Alloc>
+void AVLNode<T, Compare>::destroyAll(AVLNode *root, Alloc &alloc) {
     if (root == nullptr)
-        return nullptr;
+        return;
+    destroyAll(root->left, alloc);
+    destroyAll(root->right, alloc);
+    destroy(root, alloc);
+}
 
-    if (equal(key, root->data))
-        return root;
-    else if (less(key, root->data))
-        return find(root->left, key);
+template <typename T, typename Compare>
+template <typename Alloc>
+AVLNode<T, Compare> *AVLNode<T, Compare>::insert(AVLNode *root, const T &key,
+                                                 Alloc &alloc) {
+    return insertNode(root, create(alloc, key));
+}
 
-    return find(root->right, key);
+template <typename T, typename Compare>
+AVLNode<T, Compare> *AVLNode<T, Compare>::insertNode(AVLNode *root,
+                                                     AVLNode *node) {
+    AVLNode **path[MAX_HEIGHT];
+    int depth = 0;
+
+    AVLNode **link = &root;
+    while (*link != nullptr) {
+        path[depth++] = link;
+        link = less(node->data, (*link)->data) ? &(*link)->left
+                                               : &(*link)->right;
+    }
+
+    *link = node;
+    retrace(path, depth, 1);
+    return root;
+}
+
+template <typename T, typename Compare>
+AVLNode<T, Compare> *AVLNode<T, Compare>::find(AVLNode<T, Compare> *root,
+                                               const T &key) {
+    while (root != nullptr) {
+        std::strong_ordering order = m_compare(key, root->data);
+        if (order == 0)
+            return root;
+        root = (order < 0) ? root->left : root->right;
+    }
+    return nullptr;
 }
 
 template <typename T, typename Compare>
+template <typename Alloc>
 AVLNode<T, Compare> *AVLNode<T, Compare>::remove(AVLNode<T, Compare> *root,
+                                                 const T &key, Alloc &alloc) {
+    AVLNode *node = detach(root, key);
+    if (node != nullptr)
+        destroy(node, alloc);
+    return root;
+}
+
+template <typename T, typename Compare>
+AVLNode<T, Compare> *AVLNode<T, Compare>::detach(AVLNode *&root,
                                                  const T &key) {
-    if (root == nullptr)
-        return nullptr;
+    AVLNode **path[MAX_HEIGHT];
+    int depth = 0;
 
-    if (equal(key, root->data)) {
-        AVLNode<T, Compare> *newRoot, *succ;
-        switch (numberChildNodes(root)) {
-        case 0:
-            delete root;
+    AVLNode **link = &root;
+    for (;;) {
+        if (*link == nullptr)
             return nullptr;
-        case 1:
-            newRoot = (root->left != nullptr) ? root->left : root->right;
-            delete root;
-            root = newRoot;
-            break;
-        case 2:
-            succ = leftmost(root->right);
-            T succData = succ->data;
-            root->right = remove(root->right, succData);
-            root->data = succData;
+        std::strong_ordering order = m_compare(key, (*link)->data);
+        if (order == 0)
             break;
+        path[depth++] = link;
+        link = (order < 0) ? &(*link)->left : &(*link)->right;
+    }
+
+    AVLNode *target = *link;
+    if (numberChildNodes(target) == 2) {
+        // Swap values with the successor, then unlink the successor,
+        // which has no left child.
+        path[depth++] = link;
+        link = &target->right;
+        while ((*link)->left != nullptr) {
+            path[depth++] = link;
+            link = &(*link)->left;
         }
-    } else if (less(key, root->data)) {
-        root->left = remove(root->left, key);
-    } else {
-        root->right = remove(root->right, key);
+        using std::swap;
+        swap(target->data, (*link)->data);
+        target = *link;
     }
 
-    setHeight(root);
-    return rebalance(root);
+    *link = (target->left != nullptr) ? target->left : target->right;
+    retrace(path, depth, -1);
+
+    target->left = target->right = nullptr;
+    target->height = target->size = 1;
+    return target;
 }
 
 template <typename T, typename Compare>
@@ -480,12 +1214,33 @@ int AVLNode<T, Compare>::setHeight(AVLNode<T, Compare> *root) {
     if (root == nullptr)
         return 0;
     root->height = 1 + std::max(getHeight(root->left), getHeight(root->right));
+    root->size = 1 + getSize(root->left) + getSize(root->right);
     return root->height;
 }
 
 template <typename T, typename Compare>
 int AVLNode<T, Compare>::getHeight(AVLNode<T, Compare> *root) {
-    return (root == nullptr) ? 0 : setHeight(root);
+    return (root == nullptr) ? 0 : root->height;
+}
+
+template <typename T, typename Compare>
+int AVLNode<T, Compare>::getSize(const AVLNode<T, Compare> *root) {
+    return (root == nullptr) ? 0 : root->size;
+}
+
+template <typename T, typename Compare>
+int AVLNode<T, Compare>::countBefore(const AVLNode<T, Compare> *root,
+                                     const T &key, const bool &inclusive) {
+    int count = 0;
+    while (root != nullptr) {
+        if (inclusive ? !less(key, root->data) : less(root->data, key)) {
+            count += getSize(root->left) + 1;
+            root = root->right;
+        } else {
+            root = root->left;
+        }
+    }
+    return count;
 }
 
 template <typename T, typename Compare>
@@ -541,6 +1296,47 @@ void AVLNode<T, Compare>::postorder(AVLNode<T, Compare> *root,
     vec.push_back(root->data);
 }
 
+template <typename T, typename Compare>
+template <typename Visit>
+bool AVLNode<T, Compare>::visitPreorder(const AVLNode *root, Visit &visit) {
+    if (root == nullptr)
+        return true;
+    return callVisitor(visit, root->data) &&
+           visitPreorder(root->left, visit) &&
+           visitPreorder(root->right, visit);
+}
+
+template <typename T, typename Compare>
+template <typename Visit>
+bool AVLNode<T, Compare>::visitInorder(const AVLNode *root, Visit &visit) {
+    if (root == nullptr)
+        return true;
+    return visitInorder(root->left, visit) &&
+           callVisitor(visit, root->data) &&
+           visitInorder(root->right, visit);
+}
+
+template <typename T, typename Compare>
+template <typename Visit>
+bool AVLNode<T, Compare>::visitPostorder(const AVLNode *root, Visit &visit) {
+    if (root == nullptr)
+        return true;
+    return visitPostorder(root->left, visit) &&
+           visitPostorder(root->right, visit) &&
+           callVisitor(visit, root->data);
+}
+
+template <typename T, typename Compare>
+template <typename Visit>
+bool AVLNode<T, Compare>::callVisitor(Visit &visit, const T &value) {
+    if constexpr (std::is_void_v<std::invoke_result_t<Visit &, const T &>>) {
+        visit(value);
+        return true;
+    } else {
+        return static_cast<bool>(visit(value));
+    }
+}
+
 template <typename T, typename Compare>
 AVLNode<T, Compare> *AVLNode<T, Compare>::rebalance(AVLNode<T, Compare> *root) {
     if (root == nullptr)
@@ -573,6 +1369,22 @@ AVLNode<T, Compare> *AVLNode<T, Compare>::rebalance(AVLNode<T, Compare> *root) {
     return root;
 }
 
+template <typename T, typename Compare>
+void AVLNode<T, Compare>::retrace(AVLNode **path[], int depth,
+                                  const int &delta) {
+    while (depth > 0) {
+        AVLNode **link = path[--depth];
+        int height = (*link)->height;
+        setHeight(*link);
+        *link = rebalance(*link);
+        if ((*link)->height == height)
+            break;
+    }
+
+    while (depth > 0)
+        (*path[--depth])->size += delta;
+}
+
 template <typename T, typename Compare>
 AVLNode<T, Compare> *
 AVLNode<T, Compare>::findSuccessor(AVLNode<T, Compare> *target) {
@@ -583,26 +1395,20 @@ AVLNode<T, Compare>::findSuccessor(AVLNode<T, Compare> *target) {
 
 template <typename T, typename Compare>
 void AVLNode<T, Compare>::printPreorder(AVLNode<T, Compare> *root) {
-    std::vector<T> vec;
-    preorder(root, vec);
-    for (const auto &item : vec)
-        std::cout << item << std::endl;
+    auto print = [](const T &item) { std::cout << item << std::endl; };
+    visitPreorder(root, print);
 }
 
 template <typename T, typename Compare>
 void AVLNode<T, Compare>::printInorder(AVLNode<T, Compare> *root) {
-    std::vector<T> vec;
-    inorder(root, vec);
-    for (const auto &item : vec)
-        std::cout << item << std::endl;
+    auto print = [](const T &item) { std::cout << item << std::endl; };
+    visitInorder(root, print);
 }
 
 template <typename T, typename Compare>
 void AVLNode<T, Compare>::printPostorder(AVLNode<T, Compare> *root) {
-    std::vector<T> vec;
-    postorder(root, vec);
-    for (const auto &item : vec)
-        std::cout << item << std::endl;
+    auto print = [](const T &item) { std::cout << item << std::endl; };
+    visitPostorder(root, print);
 }
 
 template <typename T, typename Compare>
@@ -620,98 +1426,409 @@ bool AVLNode<T, Compare>::greater(const T &lhs, const T &rhs) {
     return m_compare(lhs, rhs) > 0;
 }
 
-template <typename T, typename Compare>
-AVL<T, Compare>::AVL(Compare compare)
-    : root{nullptr}, m_compare{compare}, m_size{0} {}
+template <typename T, typename Compare, bool REVERSE>
+AVLIterator<T, Compare, REVERSE>::AVLIterator()
+    : m_root{nullptr}, m_depth{0} {}
 
-template <typename T, typename Compare>
-AVL<T, Compare>::AVL(const AVL &other)
-    : root{nullptr}, m_compare{other.m_compare}, m_size{0} {
-    std::vector<T> vec;
-    AVLNode<T, Compare>::preorder(other.root, vec);
-    for (const auto &item : vec)
-        insert(item);
+template <typename T, typename Compare, bool REVERSE>
+AVLIterator<T, Compare, REVERSE>::AVLIterator(const Node *root)
+    : m_root{root}, m_depth{0} {}
+
+template <typename T, typename Compare, bool REVERSE>
+AVLIterator<T, Compare, REVERSE>::AVLIterator(const AVLIterator &other)
+    : m_root{other.m_root}, m_depth{other.m_depth} {
+    std::copy_n(other.m_path, m_depth, m_path);
 }
 
-template <typename T, typename Compare>
-AVL<T, Compare> &AVL<T, Compare>::operator=(const AVL<T, Compare> &other) {
+template <typename T, typename Compare, bool REVERSE>
+AVLIterator<T, Compare, REVERSE> &
+AVLIterator<T, Compare, REVERSE>::operator=(const AVLIterator &other) {
+    m_root = other.m_root;
+    m_depth = other.m_depth;
+    std::copy_n(other.m_path, m_depth, m_path);
+    return *this;
+}
+
+template <typename T, typename Compare, bool REVERSE>
+const AVLNode<T, Compare> *
+AVLIterator<T, Compare, REVERSE>::child(const Node *node, const bool &right) {
+    return right ? node->right : node->left;
+}
+
+template <typename T, typename Compare, bool REVERSE>
+void AVLIterator<T, Compare, REVERSE>::descend(const Node *node,
+                                               const bool &right) {
+    for (; node != nullptr; node = child(node, right))
+        m_path[m_depth++] = node;
+}
+
+template <typename T, typename Compare, bool REVERSE>
+void AVLIterator<T, Compare, REVERSE>::step(const bool &right) {
+    if (m_depth == 0) {
+        descend(m_root, !right);
+        return;
+    }
+
+    const Node *node = m_path[m_depth - 1];
+    if (child(node, right) != nullptr) {
+        descend(child(node, right), !right);
+        return;
+    }
+
+    // Climb until the path turns the other way; that ancestor is next.
+    const Node *last;
+    do {
+        last = m_path[--m_depth];
+    } while (m_depth > 0 && child(m_path[m_depth - 1], right) == last);
+}
+
+template <typename T, typename Compare, bool REVERSE>
+typename AVLIterator<T, Compare, REVERSE>::reference
+AVLIterator<T, Compare, REVERSE>::operator*() const {
+    return m_path[m_depth - 1]->data;
+}
+
+template <typename T, typename Compare, bool REVERSE>
+typename AVLIterator<T, Compare, REVERSE>::pointer
+AVLIterator<T, Compare, REVERSE>::operator->() const {
+    return &m_path[m_depth - 1]->data;
+}
+
+template <typename T, typename Compare, bool REVERSE>
+AVLIterator<T, Compare, REVERSE> &
+AVLIterator<T, Compare, REVERSE>::operator++() {
+    step(!REVERSE);
+    return *this;
+}
+
+template <typename T, typename Compare, bool REVERSE>
+AVLIterator<T, Compare, REVERSE>
+AVLIterator<T, Compare, REVERSE>::operator++(int) {
+    AVLIterator copy{*this};
+    step(!REVERSE);
+    return copy;
+}
+
+template <typename T, typename Compare, bool REVERSE>
+AVLIterator<T, Compare, REVERSE> &
+AVLIterator<T, Compare, REVERSE>::operator--() {
+    step(REVERSE);
+    return *this;
+}
+
+template <typename T, typename Compare, bool REVERSE>
+AVLIterator<T, Compare, REVERSE>
+AVLIterator<T, Compare, REVERSE>::operator--(int) {
+    AVLIterator copy{*this};
+    step(REVERSE);
+    return copy;
+}
+
+template <typename T, typename Compare, bool REVERSE>
+const AVLNode<T, Compare> *AVLIterator<T, Compare, REVERSE>::node() const {
+    return m_depth == 0 ? nullptr : m_path[m_depth - 1];
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+AVLNodeHandle<T, Compare, Alloc>::AVLNodeHandle()
+    : m_node{nullptr}, m_lease{} {}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+AVLNodeHandle<T, Compare, Alloc>::AVLNodeHandle(Node *node, Lease &&lease)
+    : m_node{node}, m_lease{std::move(lease)} {}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+AVLNodeHandle<T, Compare, Alloc>::AVLNodeHandle(
+    AVLNodeHandle &&other) noexcept
+    : m_node{other.m_node}, m_lease{std::move(other.m_lease)} {
+    other.m_node = nullptr;
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+AVLNodeHandle<T, Compare, Alloc> &
+AVLNodeHandle<T, Compare, Alloc>::operator=(AVLNodeHandle &&other) noexcept {
     if (this == &other)
         return *this;
 
-    removeAll();
+    reset();
+    m_node = other.m_node;
+    m_lease = std::move(other.m_lease);
+    other.m_node = nullptr;
+    return *this;
+}
 
-    std::vector<T> vec;
-    AVLNode<T, Compare>::preorder(other.root, vec);
-    for (const auto &item : vec)
-        insert(item);
+template <typename T, typename Compare, template <typename> class Alloc>
+AVLNodeHandle<T, Compare, Alloc>::~AVLNodeHandle() {
+    reset();
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+void AVLNodeHandle<T, Compare, Alloc>::reset() {
+    if (m_node == nullptr)
+        return;
+    m_node->~Node();
+    Alloc<Node>::release(m_node, m_lease);
+    m_node = nullptr;
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+bool AVLNodeHandle<T, Compare, Alloc>::empty() const {
+    return m_node == nullptr;
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+AVLNodeHandle<T, Compare, Alloc>::operator bool() const {
+    return m_node != nullptr;
+}
 
+template <typename T, typename Compare, template <typename> class Alloc>
+T &AVLNodeHandle<T, Compare, Alloc>::value() const {
+    return m_node->data;
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+AVL<T, Compare, Alloc>::AVL(Compare compare)
+    : root{nullptr}, m_compare{compare} {}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+AVL<T, Compare, Alloc>::AVL(const AVL &other)
+    : root{nullptr}, m_compare{other.m_compare} {
+    other.forEachPreorder([this](const T &item) { insert(item); });
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+AVL<T, Compare, Alloc> &AVL<T, Compare, Alloc>::operator=(const AVL &other) {
+    if (this == &other)
+        return *this;
+
+    removeAll();
+    other.forEachPreorder([this](const T &item) { insert(item); });
     return *this;
 }
 
-template <typename T, typename Compare>
-void AVL<T, Compare>::insert(const T &key) {
-    root = AVLNode<T, Compare>::insert(root, key);
-    ++m_size;
+template <typename T, typename Compare, template <typename> class Alloc>
+void AVL<T, Compare, Alloc>::insert(const T &key) {
+    root = AVLNode<T, Compare>::insert(root, key, m_alloc);
 }
 
-template <typename T, typename Compare>
-AVLNode<T, Compare> *AVL<T, Compare>::find(const T &key) {
+template <typename T, typename Compare, template <typename> class Alloc>
+void AVL<T, Compare, Alloc>::insert(T &&key) {
+    emplace(std::move(key));
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+template <typename... Args>
+void AVL<T, Compare, Alloc>::emplace(Args &&...args) {
+    AVLNode<T, Compare> *node =
+        AVLNode<T, Compare>::create(m_alloc, std::forward<Args>(args)...);
+    root = AVLNode<T, Compare>::insertNode(root, node);
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+void AVL<T, Compare, Alloc>::insert(node_type &&node) {
+    if (node.empty())
+        return;
+
+    m_alloc.adopt(node.m_node, std::move(node.m_lease));
+    root = AVLNode<T, Compare>::insertNode(root, node.m_node);
+    node.m_node = nullptr;
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+typename AVL<T, Compare, Alloc>::node_type
+AVL<T, Compare, Alloc>::extract(const T &key) {
+    AVLNode<T, Compare> *node = AVLNode<T, Compare>::detach(root, key);
+    if (node == nullptr)
+        return node_type{};
+    return node_type{node, m_alloc.lease(node)};
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+AVLNode<T, Compare> *AVL<T, Compare, Alloc>::find(const T &key) {
     return AVLNode<T, Compare>::find(root, key);
 }
 
-template <typename T, typename Compare>
-void AVL<T, Compare>::remove(const T &key) {
-    root = AVLNode<T, Compare>::remove(root, key);
-    --m_size;
+template <typename T, typename Compare, template <typename> class Alloc>
+void AVL<T, Compare, Alloc>::remove(const T &key) {
+    root = AVLNode<T, Compare>::remove(root, key, m_alloc);
 }
 
-template <typename T, typename Compare> void AVL<T, Compare>::removeAll() {
-    while (!empty())
-        remove(root->data);
+template <typename T, typename Compare, template <typename> class Alloc>
+void AVL<T, Compare, Alloc>::removeAll() {
+    AVLNode<T, Compare>::destroyAll(root, m_alloc);
+    root = nullptr;
 }
 
-template <typename T, typename Compare>
-std::vector<T> AVL<T, Compare>::preorder() {
+template <typename T, typename Compare, template <typename> class Alloc>
+typename AVL<T, Compare, Alloc>::const_iterator
+AVL<T, Compare, Alloc>::begin() const {
+    const_iterator it{root};
+    it.descend(root, false);
+    return it;
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+typename AVL<T, Compare, Alloc>::const_iterator
+AVL<T, Compare, Alloc>::end() const {
+    return const_iterator{root};
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+typename AVL<T, Compare, Alloc>::const_reverse_iterator
+AVL<T, Compare, Alloc>::rbegin() const {
+    const_reverse_iterator it{root};
+    it.descend(root, true);
+    return it;
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+typename AVL<T, Compare, Alloc>::const_reverse_iterator
+AVL<T, Compare, Alloc>::rend() const {
+    return const_reverse_iterator{root};
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+typename AVL<T, Compare, Alloc>::const_iterator
+AVL<T, Compare, Alloc>::select(const int &k) const {
+    const_iterator it{root};
+    if (k < 0 || k >= size())
+        return it;
+
+    // Every node passed on the way down is an ancestor of the k-th
+    // value, so the path doubles as the iterator's.
+    const AVLNode<T, Compare> *node = root;
+    for (int left = k;;) {
+        it.m_path[it.m_depth++] = node;
+        int below = AVLNode<T, Compare>::getSize(node->left);
+        if (left == below)
+            return it;
+        if (left < below) {
+            node = node->left;
+        } else {
+            left -= below + 1;
+            node = node->right;
+        }
+    }
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+int AVL<T, Compare, Alloc>::rank(const T &key) const {
+    return AVLNode<T, Compare>::countBefore(root, key, false);
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+int AVL<T, Compare, Alloc>::countInRange(const T &lo, const T &hi) const {
+    if (AVLNode<T, Compare>::less(hi, lo))
+        return 0;
+    return AVLNode<T, Compare>::countBefore(root, hi, true) -
+           AVLNode<T, Compare>::countBefore(root, lo, false);
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+typename AVL<T, Compare, Alloc>::const_iterator
+AVL<T, Compare, Alloc>::lowerBound(const T &key) const {
+    const_iterator it{root};
+    int found = 0; // path depth of the best candidate so far
+    for (const AVLNode<T, Compare> *node = root; node != nullptr;) {
+        it.m_path[it.m_depth++] = node;
+        if (AVLNode<T, Compare>::less(node->data, key)) {
+            node = node->right;
+        } else {
+            found = it.m_depth;
+            node = node->left;
+        }
+    }
+    it.m_depth = found;
+    return it;
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+typename AVL<T, Compare, Alloc>::const_iterator
+AVL<T, Compare, Alloc>::upperBound(const T &key) const {
+    const_iterator it{root};
+    int found = 0; // path depth of the best candidate so far
+    for (const AVLNode<T, Compare> *node = root; node != nullptr;) {
+        it.m_path[it.m_depth++] = node;
+        if (AVLNode<T, Compare>::less(key, node->data)) {
+            found = it.m_depth;
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+    it.m_depth = found;
+    return it;
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+template <typename Visit>
+bool AVL<T, Compare, Alloc>::forEach(Visit &&visit) const {
+    return AVLNode<T, Compare>::visitInorder(root, visit);
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+template <typename Visit>
+bool AVL<T, Compare, Alloc>::forEachPreorder(Visit &&visit) const {
+    return AVLNode<T, Compare>::visitPreorder(root, visit);
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+template <typename Visit>
+bool AVL<T, Compare, Alloc>::forEachPostorder(Visit &&visit) const {
+    return AVLNode<T, Compare>::visitPostorder(root, visit);
+}
+
+template <typename T, typename Compare, template <typename> class Alloc>
+std::vector<T> AVL<T, Compare, Alloc>::preorder() const {
     std::vector<T> vec;
+    vec.reserve(size());
     AVLNode<T, Compare>::preorder(root, vec);
     return vec;
 }
 
-template <typename T, typename Compare>
-std::vector<T> AVL<T, Compare>::inorder() {
+template <typename T, typename Compare, template <typename> class Alloc>
+std::vector<T> AVL<T, Compare, Alloc>::inorder() const {
     std::vector<T> vec;
+    vec.reserve(size());
     AVLNode<T, Compare>::inorder(root, vec);
     return vec;
 }
 
-template <typename T, typename Compare>
-std::vector<T> AVL<T, Compare>::postorder() {
+template <typename T, typename Compare, template <typename> class Alloc>
+std::vector<T> AVL<T, Compare, Alloc>::postorder() const {
     std::vector<T> vec;
+    vec.reserve(size());
     AVLNode<T, Compare>::postorder(root, vec);
     return vec;
 }
 
-template <typename T, typename Compare> void AVL<T, Compare>::printPreorder() {
+template <typename T, typename Compare, template <typename> class Alloc>
+void AVL<T, Compare, Alloc>::printPreorder() {
     AVLNode<T, Compare>::printPreorder(root);
 }
 
-template <typename T, typename Compare> void AVL<T, Compare>::printInorder() {
+template <typename T, typename Compare, template <typename> class Alloc>
+void AVL<T, Compare, Alloc>::printInorder() {
     AVLNode<T, Compare>::printInorder(root);
 }
 
-template <typename T, typename Compare> void AVL<T, Compare>::printPostorder() {
+template <typename T, typename Compare, template <typename> class Alloc>
+void AVL<T, Compare, Alloc>::printPostorder() {
     AVLNode<T, Compare>::printPostorder(root);
 }
 
-template <typename T, typename Compare> bool AVL<T, Compare>::empty() const {
+template <typename T, typename Compare, template <typename> class Alloc>
+bool AVL<T, Compare, Alloc>::empty() const {
     return root == nullptr;
 }
 
-template <typename T, typename Compare> int AVL<T, Compare>::size() const {
-    return m_size;
+template <typename T, typename Compare, template <typename> class Alloc>
+int AVL<T, Compare, Alloc>::size() const {
+    return AVLNode<T, Compare>::getSize(root);
 }
 
-template <typename T, typename Compare> AVL<T, Compare>::~AVL() {
+template <typename T, typename Compare, template <typename> class Alloc>
+AVL<T, Compare, Alloc>::~AVL() {
     removeAll();
 }
 
@@ -0,0 +1,575 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+#pragma once
+
+#include "hash.h"
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional> // std::equal_to, std::hash
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pone {
+
+// +--------------------------------+
+// + Default hashers                +
+// +--------------------------------+
+
+/* Default hash functor for FlatHashMap keys.
+ *
+ * @note Integers are mixed with mix64, so that keys that differ only
+ *       in their high bits still spread over a power-of-two table.
+ */
+template <typename K> struct FlatHash {
+    /* Hashes a key.
+     *
+     * @param key the key.
+     * @return a 64-bit hash value.
+     */
+    std::uint64_t operator()(const K &key) const
+        requires std::integral<K> || std::is_enum_v<K>
+    {
+        return mix64(static_cast<std::uint64_t>(key));
+    }
+};
+
+/* Hash functor for string keys.
+ *
+ * @note This is transparent, so a FlatHashMap with std::string keys
+ *       can be searched with a std::string_view or a C string
+ *       without building a std::string.
+ */
+template <> struct FlatHash<std::string> {
+    using is_transparent = void;
+
+    /* Hashes a string.
+     *
+     * @param key the string.
+     * @return a 64-bit hash value.
+     */
+    std::uint64_t operator()(std::string_view key) const {
+        return mix64(std::hash<std::string_view>{}(key));
+    }
+};
+
+/* Hash functor for pairs of integers, such as coordinates.
+ *
+ * @note Both halves are packed into one 64-bit value before mixing,
+ *       so (x, y) and (y, x) hash differently.
+ */
+template <std::integral A, std::integral B>
+struct FlatHash<std::pair<A, B>> {
+    /* Hashes a pair of integers.
+     *
+     * @param key the pair.
+     * @return a 64-bit hash value.
+     */
+    std::uint64_t operator()(const std::pair<A, B> &key) const {
+        return mix64(static_cast<std::uint64_t>(
+                         static_cast<std::uint32_t>(key.first))
+                         << 32 |
+                     static_cast<std::uint32_t>(key.second));
+    }
+};
+
+// +--------------------------------+
+// + FlatHashMap                    +
+// +--------------------------------+
+
+/* Open-addressing hash map with linear probing.
+ *
+ * Entries live in one contiguous array next to an array of 32-bit
+ * tags (a slice of each entry's hash, or 0 for an empty slot), so
+ * a lookup compares tags in one cache line before it touches a key.
+ * Removal shifts the following entries back instead of leaving
+ * tombstones, so lookups never slow down as the map churns.
+ *
+ * @note Inserting may move every entry, and removing may move the
+ *       entries after the removed one. Either invalidates iterators
+ *       and references into the map.
+ * @note Keys and values must be default constructible; empty slots
+ *       hold default values.
+ * @tparam K the key type.
+ * @tparam V the mapped type.
+ * @tparam Hash a hash functor returning a 64-bit value.
+ * @tparam KeyEqual a key equality functor.
+ */
+template <typename K, typename V, typename Hash = FlatHash<K>,
+          typename KeyEqual = std::equal_to<>>
+class FlatHashMap {
+  public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using size_type = std::size_t;
+
+    /* Forward iterator over the entries of a FlatHashMap.
+     *
+     * @tparam Const true for a const_iterator.
+     */
+    template <bool Const> class Iterator {
+        using Entry = std::pair<K, V>;
+        using Value = std::conditional_t<Const, const Entry, Entry>;
+
+        Value *m_slot;
+        const std::uint32_t *m_tag, *m_end;
+
+        /* Advances past empty slots. */
+        void skip() {
+            while (m_tag != m_end && *m_tag == 0) {
+                ++m_tag;
+                ++m_slot;
+            }
+        }
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value *;
+        using reference = Value &;
+
+        Iterator() : m_slot{nullptr}, m_tag{nullptr}, m_end{nullptr} {}
+
+        /* Iterator constructor.
+         *
+         * @param slot the entry at the iterator position.
+         * @param tag the tag of the entry.
+         * @param end one past the last tag of the map.
+         */
+        Iterator(Value *slot, const std::uint32_t *tag,
+                 const std::uint32_t *end)
+            : m_slot{slot}, m_tag{tag}, m_end{end} {
+            skip();
+        }
+
+        /* Converts an iterator to a const_iterator. */
+        operator Iterator<true>() const
+            requires(!Const)
+        {
+            return Iterator<true>(m_slot, m_tag, m_end);
+        }
+
+        reference operator*() const { return *m_slot; }
+        pointer operator->() const { return m_slot; }
+
+        Iterator &operator++() {
+            ++m_tag;
+            ++m_slot;
+            skip();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return m_tag == other.m_tag;
+        }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+  private:
+    // +--------------------------------+
+    // + FlatHashMap data members       +
+    // +--------------------------------+
+
+    // Tag of each slot: the high bits of the hash with the top bit
+    // set, or 0 if the slot is empty. The low bits of the tag are
+    // also the slot an entry would like to be in.
+    std::vector<std::uint32_t> m_tags;
+    std::vector<value_type> m_slots;
+    size_type m_size;
+    Hash m_hash;
+    KeyEqual m_equal;
+
+    static constexpr size_type MIN_CAPACITY = 16;
+
+    // +--------------------------------+
+    // + FlatHashMap helpers            +
+    // +--------------------------------+
+
+    /* Computes the tag of a key.
+     *
+     * @param key the key.
+     * @return a non-zero tag.
+     */
+    template <typename Q> std::uint32_t tag(const Q &key) const;
+
+    /* Gets the slot mask of the table.
+     *
+     * @return the capacity minus one.
+     */
+    size_type mask() const;
+
+    /* Finds the slot holding a key.
+     *
+     * @param key the key.
+     * @return the slot index, or the capacity if the key is absent.
+     */
+    template <typename Q> size_type locate(const Q &key) const;
+
+    /* Rebuilds the table with a new capacity.
+     *
+     * @param capacity the new capacity, a power of two.
+     */
+    void rehash(const size_type &capacity);
+
+    /* Empties a slot, shifting the entries after it back
+     * so that no probe sequence is broken.
+     *
+     * @param i the slot index.
+     */
+    void vacate(size_type i);
+
+  public:
+    // +--------------------------------+
+    // + FlatHashMap constructors       +
+    // +--------------------------------+
+
+    /* FlatHashMap constructor.
+     * Usage: FlatHashMap<std::string, int> map;
+     */
+    FlatHashMap();
+
+    // +--------------------------------+
+    // + FlatHashMap iterators          +
+    // +--------------------------------+
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    // +--------------------------------+
+    // + FlatHashMap lookup             +
+    // +--------------------------------+
+
+    /* Finds an entry by key.
+     *
+     * @param key the key, or any value the hash and equality
+     *            functors accept, such as a std::string_view.
+     * @return an iterator to the entry, or end().
+     */
+    template <typename Q> iterator find(const Q &key);
+
+    /* Finds an entry by key.
+     *
+     * @param key the key.
+     * @return an iterator to the entry, or end().
+     */
+    template <typename Q> const_iterator find(const Q &key) const;
+
+    /* Checks if the map has a key.
+     *
+     * @param key the key.
+     * @return true if the key is in the map, otherwise false.
+     */
+    template <typename Q> bool contains(const Q &key) const;
+
+    // +--------------------------------+
+    // + FlatHashMap modifiers          +
+    // +--------------------------------+
+
+    /* Inserts an entry if its key is absent.
+     *
+     * @param key the key.
+     * @param args the arguments to construct the value with.
+     * @return an iterator to the entry with the key, and true if
+     *         the entry was inserted.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(K key, Args &&...args);
+
+    /* Gets the value of a key, inserting a default value
+     * if the key is absent.
+     *
+     * @param key the key.
+     * @return the value.
+     */
+    V &operator[](K key);
+
+    /* Removes the entry with a key.
+     *
+     * @param key the key.
+     * @return 1 if an entry was removed, otherwise 0.
+     */
+    template <typename Q> size_type erase(const Q &key);
+
+    /* Removes every entry, keeping the capacity. */
+    void clear();
+
+    /* Makes room for a number of entries without rehashing.
+     *
+     * @param count the number of entries.
+     */
+    void reserve(const size_type &count);
+
+    // +--------------------------------+
+    // + FlatHashMap capacity           +
+    // +--------------------------------+
+
+    /* Checks if the map is empty.
+     *
+     * @return true if the map has no entries, otherwise false.
+     */
+    bool empty() const;
+
+    /* Gets the number of entries.
+     *
+     * @return the size.
+     */
+    size_type size() const;
+
+    /* Gets the number of slots.
+     *
+     * @return the capacity.
+     */
+    size_type capacity() const;
+};
+
+// +--------------------------------+
+// + FlatHashMap helpers            +
+// +--------------------------------+
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename Q>
+std::uint32_t FlatHashMap<K, V, Hash, KeyEqual>::tag(const Q &key) const {
+    return static_cast<std::uint32_t>(m_hash(key) >> 32) | 0x80000000u;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Hash, KeyEqual>::size_type
+FlatHashMap<K, V, Hash, KeyEqual>::mask() const {
+    return m_tags.size() - 1;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename Q>
+typename FlatHashMap<K, V, Hash, KeyEqual>::size_type
+FlatHashMap<K, V, Hash, KeyEqual>::locate(const Q &key) const {
+    if (m_size == 0)
+        return m_tags.size();
+
+    std::uint32_t t = tag(key);
+    for (size_type i = t & mask();; i = (i + 1) & mask()) {
+        if (m_tags[i] == 0)
+            return m_tags.size();
+        else if (m_tags[i] == t && m_equal(m_slots[i].first, key))
+            return i;
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Hash, KeyEqual>::rehash(const size_type &capacity) {
+    std::vector<std::uint32_t> tags(capacity, 0);
+    std::vector<value_type> slots(capacity);
+
+    for (size_type j = 0; j < m_tags.size(); ++j) {
+        if (m_tags[j] == 0)
+            continue;
+
+        size_type i = m_tags[j] & (capacity - 1);
+        while (tags[i] != 0)
+            i = (i + 1) & (capacity - 1);
+        tags[i] = m_tags[j];
+        slots[i] = std::move(m_slots[j]);
+    }
+
+    m_tags = std::move(tags);
+    m_slots = std::move(slots);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Hash, KeyEqual>::vacate(size_type i) {
+    // An entry after i may move into i unless it would then sit
+    // before its own home slot.
+    for (size_type j = (i + 1) & mask(); m_tags[j] != 0;
+         j = (j + 1) & mask()) {
+        size_type home = m_tags[j] & mask();
+        if (((j - home) & mask()) >= ((j - i) & mask())) {
+            m_tags[i] = m_tags[j];
+            m_slots[i] = std::move(m_slots[j]);
+            i = j;
+        }
+    }
+
+    m_tags[i] = 0;
+    m_slots[i] = value_type{};
+}
+
+// +--------------------------------+
+// + FlatHashMap constructors       +
+// +--------------------------------+
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Hash, KeyEqual>::FlatHashMap() : m_size{0} {}
+
+// +--------------------------------+
+// + FlatHashMap iterators          +
+// +--------------------------------+
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Hash, KeyEqual>::iterator
+FlatHashMap<K, V, Hash, KeyEqual>::begin() {
+    return iterator(m_slots.data(), m_tags.data(),
+                    m_tags.data() + m_tags.size());
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Hash, KeyEqual>::iterator
+FlatHashMap<K, V, Hash, KeyEqual>::end() {
+    const std::uint32_t *last = m_tags.data() + m_tags.size();
+    return iterator(m_slots.data() + m_slots.size(), last, last);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Hash, KeyEqual>::const_iterator
+FlatHashMap<K, V, Hash, KeyEqual>::begin() const {
+    return const_iterator(m_slots.data(), m_tags.data(),
+                          m_tags.data() + m_tags.size());
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Hash, KeyEqual>::const_iterator
+FlatHashMap<K, V, Hash, KeyEqual>::end() const {
+    const std::uint32_t *last = m_tags.data() + m_tags.size();
+    return const_iterator(m_slots.data() + m_slots.size(), last, last);
+}
+
+// +--------------------------------+
+// + FlatHashMap lookup             +
+// +--------------------------------+
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename Q>
+typename FlatHashMap<K, V, Hash, KeyEqual>::iterator
+FlatHashMap<K, V, Hash, KeyEqual>::find(const Q &key) {
+    size_type i = locate(key);
+    if (i == m_tags.size())
+        return end();
+
+    return iterator(m_slots.data() + i, m_tags.data() + i,
+                    m_tags.data() + m_tags.size());
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename Q>
+typename FlatHashMap<K, V, Hash, KeyEqual>::const_iterator
+FlatHashMap<K, V, Hash, KeyEqual>::find(const Q &key) const {
+    size_type i = locate(key);
+    if (i == m_tags.size())
+        return end();
+
+    return const_iterator(m_slots.data() + i, m_tags.data() + i,
+                          m_tags.data() + m_tags.size());
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename Q>
+bool FlatHashMap<K, V, Hash, KeyEqual>::contains(const Q &key) const {
+    return locate(key) != m_tags.size();
+}
+
+// +--------------------------------+
+// + FlatHashMap modifiers          +
+// +--------------------------------+
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename... Args>
+std::pair<typename FlatHashMap<K, V, Hash, KeyEqual>::iterator, bool>
+FlatHashMap<K, V, Hash, KeyEqual>::emplace(K key, Args &&...args) {
+    // Keep the load factor at most 7/8.
+    if ((m_size + 1) * 8 > m_tags.size() * 7)
+        rehash(m_tags.empty() ? MIN_CAPACITY : m_tags.size() * 2);
+
+    std::uint32_t t = tag(key);
+    size_type i = t & mask();
+    for (; m_tags[i] != 0; i = (i + 1) & mask()) {
+        if (m_tags[i] == t && m_equal(m_slots[i].first, key))
+            return {iterator(m_slots.data() + i, m_tags.data() + i,
+                             m_tags.data() + m_tags.size()),
+                    false};
+    }
+
+    m_tags[i] = t;
+    m_slots[i] = value_type(std::move(key), V(std::forward<Args>(args)...));
+    ++m_size;
+    return {iterator(m_slots.data() + i, m_tags.data() + i,
+                     m_tags.data() + m_tags.size()),
+            true};
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+V &FlatHashMap<K, V, Hash, KeyEqual>::operator[](K key) {
+    return emplace(std::move(key)).first->second;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename Q>
+typename FlatHashMap<K, V, Hash, KeyEqual>::size_type
+FlatHashMap<K, V, Hash, KeyEqual>::erase(const Q &key) {
+    size_type i = locate(key);
+    if (i == m_tags.size())
+        return 0;
+
+    vacate(i);
+    --m_size;
+    return 1;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Hash, KeyEqual>::clear() {
+    for (size_type i = 0; i < m_tags.size(); ++i) {
+        if (m_tags[i] != 0) {
+            m_tags[i] = 0;
+            m_slots[i] = value_type{};
+        }
+    }
+    m_size = 0;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Hash, KeyEqual>::reserve(const size_type &count) {
+    size_type capacity = MIN_CAPACITY;
+    while (count * 8 > capacity * 7)
+        capacity *= 2;
+
+    if (capacity > m_tags.size())
+        rehash(capacity);
+}
+
+// +--------------------------------+
+// + FlatHashMap capacity           +
+// +--------------------------------+
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool FlatHashMap<K, V, Hash, KeyEqual>::empty() const {
+    return m_size == 0;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Hash, KeyEqual>::size_type
+FlatHashMap<K, V, Hash, KeyEqual>::size() const {
+    return m_size;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Hash, KeyEqual>::size_type
+FlatHashMap<K, V, Hash, KeyEqual>::capacity() const {
+    return m_tags.size();
+}
+
+} // namespace pone
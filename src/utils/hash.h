@@ -0,0 +1,36 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace pone {
+
+/* Mixes the bits of a 64-bit value.
+ *
+ * @note This is the finalizer of the SplitMix64 generator. Every input
+ *       bit affects every output bit, so it is suitable for hashing
+ *       packed integers and for deriving Zobrist keys.
+ * @param x the value to mix.
+ * @return the mixed value.
+ */
+constexpr std::uint64_t mix64(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/* Mixes two 64-bit values into one.
+ *
+ * @param a the first value.
+ * @param b the second value.
+ * @return the mixed value.
+ */
+constexpr std::uint64_t mix64(std::uint64_t a, std::uint64_t b) {
+    return mix64(mix64(a) ^ b);
+}
+
+} // namespace pone
@@ -1,9 +1,44 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
 #include <vector>
 
-#include "game/pone_avl.hpp"
+#include "utils/avl.h"
 using namespace pone;
 
+namespace {
+
+/* Checks the AVL invariants of a subtree.
+ *
+ * @return the height of the subtree, or -1 if it is broken.
+ */
+int checkSubtree(const AVLNode<int> *root) {
+    if (root == nullptr)
+        return 0;
+    int left = checkSubtree(root->left), right = checkSubtree(root->right);
+    if (left < 0 || right < 0 || left - right > 1 || right - left > 1)
+        return -1;
+    int size = 1 + (root->left ? root->left->size : 0) +
+               (root->right ? root->right->size : 0);
+    int height = 1 + std::max(left, right);
+    return (root->size == size && root->height == height) ? height : -1;
+}
+
+/* Orders unique_ptrs by the values they point to. */
+struct PointeeComparator {
+    std::strong_ordering operator()(const std::unique_ptr<int> &lhs,
+                                    const std::unique_ptr<int> &rhs) {
+        return *lhs <=> *rhs;
+    }
+};
+
+} // namespace
+
 TEST(avl_test, Constructor) {
     AVL<int> tree;
     EXPECT_TRUE(tree.empty());
@@ -93,3 +128,230 @@ TEST(avl_test, Greater) {
     AVLNode<int> node{-4};
     EXPECT_TRUE(node.greater(-4, -7));
 }
+
+TEST(avl_test, Iterators) {
+    AVL<int> tree;
+    EXPECT_EQ(tree.begin(), tree.end());
+    EXPECT_EQ(tree.rbegin(), tree.rend());
+
+    for (int i = 0; i < 100; ++i)
+        tree.insert((i * 37) % 100);
+
+    std::vector<int> forward{tree.begin(), tree.end()};
+    EXPECT_EQ(forward, tree.inorder());
+
+    std::vector<int> backward{tree.rbegin(), tree.rend()};
+    std::vector<int> reversed{forward.rbegin(), forward.rend()};
+    EXPECT_EQ(backward, reversed);
+
+    auto it = tree.end();
+    EXPECT_EQ(*--it, 99);
+    EXPECT_EQ(*std::prev(tree.end(), 100), 0);
+    EXPECT_EQ(std::distance(tree.begin(), tree.end()), 100);
+}
+
+TEST(avl_test, ForEach) {
+    AVL<int> tree;
+    for (int i = 0; i < 10; ++i)
+        tree.insert((i * 3) % 10);
+
+    std::vector<int> values;
+    EXPECT_TRUE(tree.forEach([&](const int &x) { values.push_back(x); }));
+    EXPECT_EQ(values, tree.inorder());
+
+    values.clear();
+    EXPECT_TRUE(
+        tree.forEachPreorder([&](const int &x) { values.push_back(x); }));
+    EXPECT_EQ(values, tree.preorder());
+
+    values.clear();
+    EXPECT_TRUE(
+        tree.forEachPostorder([&](const int &x) { values.push_back(x); }));
+    EXPECT_EQ(values, tree.postorder());
+
+    values.clear();
+    EXPECT_FALSE(tree.forEach([&](const int &x) {
+        values.push_back(x);
+        return x < 4;
+    }));
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(avl_test, OrderStatistics) {
+    AVL<int> tree;
+    std::vector<int> sorted;
+    for (int i = 0; i < 200; ++i) {
+        tree.insert((i * 37) % 101);
+        sorted.push_back((i * 37) % 101);
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    tree.remove(1000);
+    ASSERT_EQ(tree.size(), 200);
+
+    for (int k = 0; k < 200; ++k)
+        EXPECT_EQ(*tree.select(k), sorted[k]);
+    EXPECT_EQ(tree.select(200), tree.end());
+    EXPECT_EQ(tree.select(-1), tree.end());
+    EXPECT_EQ(*std::next(tree.select(10), 5), sorted[15]);
+
+    for (int key = -1; key <= 102; ++key) {
+        auto lower = std::lower_bound(sorted.begin(), sorted.end(), key);
+        auto upper = std::upper_bound(sorted.begin(), sorted.end(), key);
+        EXPECT_EQ(tree.rank(key), lower - sorted.begin());
+        EXPECT_EQ(std::distance(tree.begin(), tree.lowerBound(key)),
+                  lower - sorted.begin());
+        EXPECT_EQ(std::distance(tree.begin(), tree.upperBound(key)),
+                  upper - sorted.begin());
+        EXPECT_EQ(tree.countInRange(key, key + 10),
+                  std::upper_bound(sorted.begin(), sorted.end(), key + 10) -
+                      lower);
+    }
+    EXPECT_EQ(tree.countInRange(50, 40), 0);
+}
+
+TEST(avl_test, NodePool) {
+    AVLNodePool<AVLNode<int>> pool;
+    void *a = pool.allocate();
+    void *b = pool.allocate();
+    EXPECT_EQ(static_cast<char *>(b) - static_cast<char *>(a),
+              static_cast<std::ptrdiff_t>(sizeof(AVLNode<int>)));
+
+    pool.deallocate(a);
+    EXPECT_EQ(pool.allocate(), a);
+
+    AVL<int> pooled;
+    AVL<int, DefaultComparator<int>, AVLHeapAllocator> heap;
+    for (int i = 0; i < 1000; ++i) {
+        pooled.insert((i * 7) % 1000);
+        heap.insert((i * 7) % 1000);
+        if (i % 3 == 0) {
+            pooled.remove(i / 2);
+            heap.remove(i / 2);
+        }
+    }
+    EXPECT_EQ(pooled.inorder(), heap.inorder());
+
+    AVL<int> copy{pooled};
+    pooled.removeAll();
+    EXPECT_TRUE(pooled.empty());
+    EXPECT_EQ(copy.inorder(), heap.inorder());
+}
+
+TEST(avl_test, RandomInsertRemove) {
+    std::mt19937 rng{3};
+    AVLNodePool<AVLNode<int>> pool;
+    AVLNode<int> *root = nullptr;
+    std::multiset<int> expected;
+
+    for (int k = 0; k < 5000; ++k) {
+        int key = rng() % 300;
+        if (rng() % 3) {
+            root = AVLNode<int>::insert(root, key, pool);
+            expected.insert(key);
+        } else {
+            root = AVLNode<int>::remove(root, key, pool);
+            if (expected.count(key))
+                expected.erase(expected.find(key));
+        }
+        ASSERT_GE(checkSubtree(root), 0);
+        ASSERT_EQ(AVLNode<int>::getSize(root),
+                  static_cast<int>(expected.size()));
+        ASSERT_EQ(AVLNode<int>::find(root, key) != nullptr,
+                  expected.count(key) > 0);
+    }
+
+    std::vector<int> values;
+    AVLNode<int>::inorder(root, values);
+    EXPECT_EQ(values, std::vector<int>(expected.begin(), expected.end()));
+    AVLNode<int>::destroyAll(root, pool);
+}
+
+TEST(avl_test, MoveAndEmplace) {
+    AVL<std::unique_ptr<int>, PointeeComparator> tree;
+    for (int i = 0; i < 10; ++i)
+        tree.insert(std::make_unique<int>((i * 3) % 10));
+    tree.emplace(new int{10});
+    ASSERT_EQ(tree.size(), 11);
+
+    int expected = 0;
+    for (const std::unique_ptr<int> &p : tree)
+        EXPECT_EQ(*p, expected++);
+
+    std::shared_ptr<int> shared = std::make_shared<int>(1);
+    AVL<std::shared_ptr<int>> owners;
+    owners.insert(std::move(shared));
+    EXPECT_EQ(shared, nullptr);
+    EXPECT_EQ(owners.begin()->use_count(), 1);
+}
+
+TEST(avl_test, ExtractAndInsertNode) {
+    using Tree = AVL<int, DefaultComparator<int>, AVLHeapAllocator>;
+    Tree from, to;
+    for (int i = 0; i < 20; ++i)
+        from.insert(i);
+
+    EXPECT_TRUE(from.extract(100).empty());
+
+    for (int i = 0; i < 20; i += 2) {
+        Tree::node_type node = from.extract(i);
+        ASSERT_TRUE(node);
+        EXPECT_EQ(node.value(), i);
+        const int *address = &node.value();
+        to.insert(std::move(node));
+        EXPECT_TRUE(node.empty());
+        EXPECT_EQ(&to.find(i)->data, address);
+    }
+    EXPECT_EQ(from.size(), 10);
+    EXPECT_EQ(to.size(), 10);
+    for (int i = 0; i < 20; ++i)
+        EXPECT_EQ(from.find(i) != nullptr, i % 2 == 1);
+
+    AVL<int> pooled;
+    for (int i = 0; i < 5; ++i)
+        pooled.insert(i);
+    pooled.insert(pooled.extract(4));
+    EXPECT_EQ(pooled.inorder(), (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(avl_test, ExtractBetweenPools) {
+    AVL<std::string> to;
+    {
+        AVL<std::string> from;
+        for (int i = 0; i < 100; ++i)
+            from.insert(std::to_string(i));
+
+        for (int i = 0; i < 100; i += 3) {
+            AVL<std::string>::node_type node = from.extract(std::to_string(i));
+            const std::string *address = &node.value();
+            node.value() += "!";
+            to.insert(std::move(node));
+            EXPECT_EQ(&to.find(std::to_string(i) + "!")->data, address);
+        }
+        to.insert(to.extract("3!"));
+    }
+
+    // The nodes outlive the tree whose pool they came from.
+    EXPECT_EQ(to.size(), 34);
+    to.remove("0!");
+    for (int i = 0; i < 10; ++i)
+        to.insert("new" + std::to_string(i));
+    EXPECT_EQ(to.size(), 43);
+    EXPECT_EQ(*to.begin(), "12!");
+
+    // So do handles, whether they are inserted or dropped.
+    AVL<std::string>::node_type kept, dropped;
+    {
+        AVL<std::string> source;
+        source.insert("x");
+        source.insert("y");
+        kept = source.extract("x");
+        dropped = source.extract("y");
+    }
+    EXPECT_EQ(kept.value(), "x");
+    AVL<std::string> target;
+    target.insert(std::move(kept));
+    EXPECT_EQ(target.inorder(), (std::vector<std::string>{"x"}));
+    dropped = AVL<std::string>::node_type{};
+    EXPECT_TRUE(dropped.empty());
+}
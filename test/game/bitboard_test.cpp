@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include "game/pone_bitboard.hpp"
+#include "game/pone_except.hpp"
+using namespace pone;
+
+namespace {
+
+/* A 3 x 2 board: a row of empty tiles with a goal at the right end,
+ * above a row holding a collision tile and two red arrows. */
+Board makeBoard() {
+    Board board{"board", 3, 2};
+    board.add(std::make_shared<Tile>("a", 1, 0, 1, "none", "empty", true));
+    board.add(std::make_shared<Tile>("b", 2, 1, 1, "none", "empty", false));
+    board.add(std::make_shared<Tile>("c", 3, 2, 1, "none", "goal", false));
+    board.add(std::make_shared<Tile>("d", 4, 0, 0, "red", "up", false));
+    board.add(
+        std::make_shared<Tile>("e", 5, 1, 0, "none", "collision", false));
+    board.add(std::make_shared<Tile>("f", 6, 2, 0, "red", "left", false));
+    board.setCursorTile(board.getTile("a"));
+    return board;
+}
+
+} // namespace
+
+TEST(bitboard_test, MirrorsBoard) {
+    Board board = makeBoard();
+    BitBoard bits{board};
+
+    EXPECT_EQ(bits.getLength(), 3);
+    EXPECT_EQ(bits.getWidth(), 2);
+    EXPECT_TRUE(bits.full());
+    EXPECT_EQ(bits.checkMove(RIGHT), board.checkMove(RIGHT));
+    EXPECT_EQ(bits.checkMove(DOWN), board.checkMove(DOWN));
+    EXPECT_EQ(bits.checkMove(UP), board.checkMove(UP));
+
+    EXPECT_THROW(BitBoard(Board{"big", 65, 1}), InvalidBoardException);
+}
+
+TEST(bitboard_test, RotateTiles) {
+    Board board = makeBoard();
+    BitBoard bits{board};
+    TileType type;
+
+    bits.rotateTiles("red", CLOCKWISE);
+    ASSERT_TRUE(bits.getTileType(0, 0, type));
+    EXPECT_EQ(type, TileType::RIGHT);
+    ASSERT_TRUE(bits.getTileType(2, 0, type));
+    EXPECT_EQ(type, TileType::UP);
+
+    bits.rotateTiles("red", COUNTER_CLOCKWISE);
+    bits.rotateTiles("red", COUNTER_CLOCKWISE);
+    ASSERT_TRUE(bits.getTileType(0, 0, type));
+    EXPECT_EQ(type, TileType::LEFT);
+    ASSERT_TRUE(bits.getTileType(1, 0, type));
+    EXPECT_EQ(type, TileType::COLLISION);
+
+    bits.rotateTiles(ColorRegistry::intern("red"), CLOCKWISE);
+    ASSERT_TRUE(bits.getTileType(0, 0, type));
+    EXPECT_EQ(type, TileType::UP);
+    bits.rotateTiles(NO_COLOR, CLOCKWISE);
+    ASSERT_TRUE(bits.getTileType(0, 0, type));
+    EXPECT_EQ(type, TileType::UP);
+}
+
+TEST(bitboard_test, Reachable) {
+    Board board = makeBoard();
+    GatePtr g = std::make_shared<Gate>(board.getTile("b"), board.getTile("c"),
+                                       "g", "none", true);
+    board.add(g);
+
+    BitBoard bits{board};
+    BitRows seen = bits.reachable();
+    EXPECT_EQ(seen[1], 0b011u);
+    EXPECT_EQ(seen[0], 0b001u);
+    EXPECT_FALSE(bits.goalReachable());
+
+    bits.setGateActive(g, false);
+    EXPECT_TRUE(bits.goalReachable());
+
+    bits.moveCursor(RIGHT);
+    bits.moveCursor(RIGHT);
+    EXPECT_TRUE(bits.cursorOnGoal());
+}
+
+TEST(bitboard_test, LookupAndEdit) {
+    Board board = makeBoard();
+    board.add(std::make_shared<Gate>(board.getTile("a"), board.getTile("b"),
+                                     "g", "red", true));
+    BitBoard bits{board};
+
+    TilePtr d = bits.getTile(0, 0);
+    ASSERT_NE(d, nullptr);
+    EXPECT_EQ(d->getName(), "d");
+    EXPECT_EQ(d->getColor(), "red");
+    EXPECT_EQ(bits.getTile("a")->getCoordPair(), (CoordPair{0, 1}));
+    EXPECT_TRUE(bits.getTile("a")->isCursor());
+    EXPECT_EQ(bits.getTile("z"), nullptr);
+    EXPECT_EQ(bits.getTile(5, 5), nullptr);
+
+    GatePtr g = bits.getGate(bits.getTile("b"), bits.getTile("a"));
+    ASSERT_NE(g, nullptr);
+    EXPECT_EQ(g->getName(), "g");
+    EXPECT_TRUE(g->isActive());
+    EXPECT_EQ(g->getTile1()->getName(), "a");
+    EXPECT_EQ(bits.getGate("g")->getTile2()->getName(), "b");
+    EXPECT_EQ(bits.getGate(d, bits.getTile("e")), nullptr);
+    EXPECT_FALSE(bits.checkMove(RIGHT));
+
+    // Copies reflect the bitboard, not the other way around.
+    bits.rotateTile(d, CLOCKWISE);
+    EXPECT_EQ(d->getTileType(), TileType::UP);
+    EXPECT_EQ(bits.getTile(0, 0)->getTileType(), TileType::RIGHT);
+    EXPECT_THROW(bits.rotateTile(bits.getTile("e"), CLOCKWISE),
+                 InvalidDirectionException);
+    EXPECT_THROW(bits.rotateTile(std::make_shared<Tile>("d", 4, 1, 1, "red",
+                                                        "up", false),
+                                 CLOCKWISE),
+                 InvalidTileException);
+
+    bits.remove(g);
+    EXPECT_EQ(bits.getGate("g"), nullptr);
+    EXPECT_TRUE(bits.checkMove(RIGHT));
+    EXPECT_THROW(bits.remove(g), InvalidGateException);
+
+    bits.remove(d);
+    EXPECT_EQ(bits.getTile(0, 0), nullptr);
+    EXPECT_EQ(bits.getTile("d"), nullptr);
+    EXPECT_FALSE(bits.full());
+    TileType type;
+    EXPECT_FALSE(bits.getTileType(0, 0, type));
+    EXPECT_THROW(bits.add(std::make_shared<Gate>(d, bits.getTile("a"), "h",
+                                                 "red")),
+                 InvalidGateException);
+
+    bits.add(d);
+    EXPECT_EQ(bits.getTile(0, 0)->getTileType(), TileType::UP);
+    EXPECT_THROW(bits.add(std::make_shared<Tile>("d", 7, 0, 0, "red", "up",
+                                                 false)),
+                 DuplicateTilesException);
+}
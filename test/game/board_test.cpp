@@ -1,4 +1,851 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
 
 #include "game/pone_board.hpp"
+#include "game/pone_except.hpp"
 using namespace pone;
+
+TEST(board_test, GetTileByCoords) {
+    Board board{"board", 3, 2};
+    TilePtr t = std::make_shared<Tile>("a", 1, 2, 1, "none", "empty", false);
+    board.add(t);
+
+    EXPECT_EQ(board.getTile(2, 1), t);
+    EXPECT_EQ(board.getTile("a"), t);
+    EXPECT_EQ(board.getTile(1, 1), nullptr);
+    EXPECT_EQ(board.getTile(3, 1), nullptr);
+    EXPECT_EQ(board.getTile(-1, 0), nullptr);
+}
+
+TEST(board_test, GetTileByDirection) {
+    Board board{"board", 3, 3};
+    TilePtr center =
+        std::make_shared<Tile>("c", 1, 1, 1, "none", "empty", false);
+    TilePtr up = std::make_shared<Tile>("u", 2, 1, 2, "none", "empty", false);
+    TilePtr left =
+        std::make_shared<Tile>("l", 3, 0, 1, "none", "empty", false);
+    board.add(center);
+    board.add(up);
+    board.add(left);
+
+    EXPECT_EQ(board.getTile(center, UP), up);
+    EXPECT_EQ(board.getTile(center, LEFT), left);
+    EXPECT_EQ(board.getTile(center, RIGHT), nullptr);
+    EXPECT_EQ(board.getTile(center, DOWN), nullptr);
+}
+
+TEST(board_test, AddRemoveTile) {
+    Board board{"board", 2, 2};
+    TilePtr t = std::make_shared<Tile>("a", 1, 0, 0, "none", "empty", false);
+    TilePtr outside =
+        std::make_shared<Tile>("b", 2, 2, 0, "none", "empty", false);
+    TilePtr sameCell =
+        std::make_shared<Tile>("c", 3, 0, 0, "none", "empty", false);
+
+    board.add(t);
+    EXPECT_FALSE(board.empty());
+    EXPECT_THROW(board.add(t), DuplicateTilesException);
+    EXPECT_THROW(board.add(sameCell), DuplicateTilesException);
+    EXPECT_THROW(board.add(outside), InvalidTileException);
+
+    board.remove(t);
+    EXPECT_TRUE(board.empty());
+    EXPECT_EQ(board.getTile(0, 0), nullptr);
+    EXPECT_EQ(board.getTile("a"), nullptr);
+    EXPECT_THROW(board.remove(t), InvalidTileException);
+}
+
+TEST(board_test, Full) {
+    Board board{"board", 2, 1};
+    board.add(std::make_shared<Tile>("a", 1, 0, 0, "none", "empty", false));
+    EXPECT_FALSE(board.full());
+    board.add(std::make_shared<Tile>("b", 2, 1, 0, "none", "empty", false));
+    EXPECT_TRUE(board.full());
+}
+
+TEST(board_test, GateBetweenTiles) {
+    Board board{"board", 2, 2};
+    TilePtr a = std::make_shared<Tile>("a", 1, 0, 0, "none", "empty", false);
+    TilePtr b = std::make_shared<Tile>("b", 2, 1, 0, "none", "empty", false);
+    TilePtr c = std::make_shared<Tile>("c", 3, 1, 1, "none", "empty", false);
+    board.add(a);
+    board.add(b);
+    board.add(c);
+
+    GatePtr g = std::make_shared<Gate>(a, b, "g", "red");
+    board.add(g);
+
+    EXPECT_EQ(board.getGate("g"), g);
+    EXPECT_EQ(board.getGate(a, b), g);
+    EXPECT_EQ(board.getGate(b, a), g);
+    EXPECT_EQ(board.getGate(a, RIGHT), g);
+    EXPECT_EQ(board.getGate(b, UP), nullptr);
+    EXPECT_THROW(board.add(std::make_shared<Gate>(a, c, "diag", "red")),
+                 InvalidGateException);
+
+    // (0, 1) is in bounds and next to both a and c, but holds no tile.
+    TilePtr off = std::make_shared<Tile>("off", 4, 0, 1, "none", "empty",
+                                         false);
+    EXPECT_THROW(board.add(std::make_shared<Gate>(a, off, "up", "red")),
+                 InvalidGateException);
+    EXPECT_THROW(board.add(std::make_shared<Gate>(off, c, "right", "red")),
+                 InvalidGateException);
+    EXPECT_EQ(board.getGate(a, UP), nullptr);
+    EXPECT_EQ(board.getGate("up"), nullptr);
+
+    board.remove(g);
+    EXPECT_EQ(board.getGate(a, b), nullptr);
+}
+
+TEST(board_test, CheckMove) {
+    Board board{"board", 3, 1};
+    TilePtr a = std::make_shared<Tile>("a", 1, 0, 0, "none", "empty", false);
+    TilePtr b = std::make_shared<Tile>("b", 2, 1, 0, "none", "empty", false);
+    TilePtr c =
+        std::make_shared<Tile>("c", 3, 2, 0, "none", "collision", false);
+    board.add(a);
+    board.add(b);
+    board.add(c);
+    board.setCursorTile(a);
+
+    EXPECT_TRUE(board.checkMove(RIGHT));
+    EXPECT_FALSE(board.checkMove(LEFT));
+    EXPECT_FALSE(board.checkMove(UP));
+
+    board.moveCursor(RIGHT);
+    EXPECT_EQ(board.getCursorTile(), b);
+    EXPECT_FALSE(board.checkMove(RIGHT));
+}
+
+TEST(board_test, TryMoveCursor) {
+    Board board{"board", 3, 1};
+    board.add(std::make_shared<Tile>("a", 1, 0, 0, "none", "empty", false));
+    board.add(std::make_shared<Tile>("b", 2, 1, 0, "none", "goal", false));
+    board.add(
+        std::make_shared<Tile>("c", 3, 2, 0, "none", "collision", false));
+    board.setCursorTile(board.getTile("a"));
+
+    EXPECT_FALSE(board.tryMoveCursor(LEFT));
+    EXPECT_FALSE(board.tryMoveCursor(UP));
+    EXPECT_FALSE(board.cursorOnGoal());
+    EXPECT_TRUE(board.tryMoveCursor(RIGHT));
+    EXPECT_TRUE(board.cursorOnGoal());
+    EXPECT_FALSE(board.tryMoveCursor(RIGHT));
+    EXPECT_EQ(board.getCursorTile()->getName(), "b");
+
+    EXPECT_TRUE(board.undo());
+    EXPECT_EQ(board.getCursorTile()->getName(), "a");
+}
+
+TEST(board_test, RotateTiles) {
+    Board board{"board", 3, 1};
+    TilePtr a = std::make_shared<Tile>("a", 1, 0, 0, "red", "up", false);
+    TilePtr b = std::make_shared<Tile>("b", 2, 1, 0, "blue", "up", false);
+    TilePtr c = std::make_shared<Tile>("c", 3, 2, 0, "red", "goal", false);
+    board.add(a);
+    board.add(b);
+    board.add(c);
+
+    board.rotateTiles("red", CLOCKWISE);
+    EXPECT_EQ(a->getTileType(), TileType::RIGHT);
+    EXPECT_EQ(b->getTileType(), TileType::UP);
+    EXPECT_EQ(c->getTileType(), TileType::GOAL);
+
+    board.rotateTile(a, COUNTER_CLOCKWISE);
+    board.rotateTile(a, COUNTER_CLOCKWISE);
+    EXPECT_EQ(a->getTileType(), TileType::LEFT);
+    EXPECT_THROW(board.rotateTile(c, CLOCKWISE), InvalidDirectionException);
+
+    board.rotateTiles(ColorRegistry::intern("red"), CLOCKWISE);
+    EXPECT_EQ(a->getTileType(), TileType::UP);
+    EXPECT_EQ(b->getTileType(), TileType::UP);
+    board.rotateTiles(NO_COLOR, CLOCKWISE);
+    board.rotateTiles(ColorRegistry::intern("unused"), CLOCKWISE);
+    EXPECT_EQ(a->getTileType(), TileType::UP);
+}
+
+TEST(board_test, RotateTilesAfterRecolor) {
+    Board board{"board", 3, 1};
+    TilePtr a = std::make_shared<Tile>("a", 1, 0, 0, "red", "up", false);
+    TilePtr b = std::make_shared<Tile>("b", 2, 1, 0, "red", "down", false);
+    TilePtr c = std::make_shared<Tile>("c", 3, 2, 0, "red", "empty", false);
+    board.add(a);
+    board.add(b);
+    board.add(c);
+
+    board.setTileColor(a, "green");
+    board.setTileType(c, "left");
+    board.remove(b);
+
+    board.rotateTiles("red", CLOCKWISE);
+    EXPECT_EQ(a->getTileType(), TileType::UP);
+    EXPECT_EQ(b->getTileType(), TileType::DOWN);
+    EXPECT_EQ(c->getTileType(), TileType::UP);
+
+    board.rotateTiles("green", CLOCKWISE);
+    EXPECT_EQ(a->getTileType(), TileType::RIGHT);
+}
+
+TEST(board_test, CheckMoveThroughGate) {
+    Board board{"board", 2, 1};
+    TilePtr a = std::make_shared<Tile>("a", 1, 0, 0, "none", "empty", false);
+    TilePtr b = std::make_shared<Tile>("b", 2, 1, 0, "none", "empty", false);
+    board.add(a);
+    board.add(b);
+    board.setCursorTile(a);
+
+    GatePtr g = std::make_shared<Gate>(a, b, "g", "red", true);
+    board.add(g);
+    EXPECT_FALSE(board.checkMove(RIGHT));
+
+    board.toggleGate(g);
+    EXPECT_FALSE(g->isActive());
+    EXPECT_TRUE(board.checkMove(RIGHT));
+
+    board.setGateActive(g, true);
+    board.setCursorTile(b);
+    EXPECT_FALSE(board.checkMove(LEFT));
+
+    board.remove(g);
+    EXPECT_TRUE(board.checkMove(LEFT));
+}
+
+TEST(board_test, StateHash) {
+    auto build = [](bool reversed) {
+        Board board{"board", 2, 1};
+        TilePtr a = std::make_shared<Tile>("a", 1, 0, 0, "red", "up", false);
+        TilePtr b = std::make_shared<Tile>("b", 2, 1, 0, "red", "goal", false);
+        if (reversed) {
+            board.add(b);
+            board.add(a);
+        } else {
+            board.add(a);
+            board.add(b);
+        }
+        board.add(std::make_shared<Gate>(a, b, "g", "red"));
+        board.setCursorTile(a);
+        return board;
+    };
+
+    Board board = build(false);
+    std::uint64_t start = board.stateHash();
+    EXPECT_EQ(start, build(true).stateHash());
+
+    board.rotateTiles("red", CLOCKWISE);
+    EXPECT_NE(board.stateHash(), start);
+    board.rotateTile(board.getTile("a"), COUNTER_CLOCKWISE);
+    EXPECT_EQ(board.stateHash(), start);
+
+    board.toggleGate(board.getGate("g"));
+    EXPECT_NE(board.stateHash(), start);
+    board.toggleGate(board.getGate("g"));
+    EXPECT_EQ(board.stateHash(), start);
+
+    board.moveCursor(RIGHT);
+    EXPECT_NE(board.stateHash(), start);
+    board.moveCursor(LEFT);
+    EXPECT_EQ(board.stateHash(), start);
+
+    TilePtr b = board.getTile("b");
+    board.remove(b);
+    EXPECT_NE(board.stateHash(), start);
+    board.add(b);
+    EXPECT_EQ(board.stateHash(), start);
+}
+
+TEST(board_test, UndoRedo) {
+    Board board{"board", 2, 1};
+    TilePtr a = std::make_shared<Tile>("a", 1, 0, 0, "red", "up", false);
+    TilePtr b = std::make_shared<Tile>("b", 2, 1, 0, "red", "goal", false);
+    GatePtr g = std::make_shared<Gate>(a, b, "g", "red");
+    board.add(a);
+    board.add(b);
+    board.add(g);
+    board.setCursorTile(a);
+    board.clearJournal();
+    std::uint64_t start = board.stateHash();
+
+    board.moveCursor(RIGHT);
+    board.rotateTiles("red", CLOCKWISE);
+    board.setTileColor(a, "blue");
+    board.toggleGate(g);
+    board.remove(b);
+    std::uint64_t end = board.stateHash();
+
+    for (int i = 0; i < 5; ++i)
+        EXPECT_TRUE(board.undo());
+    EXPECT_FALSE(board.canUndo());
+    EXPECT_EQ(board.stateHash(), start);
+    EXPECT_EQ(board.getTile(1, 0), b);
+    EXPECT_EQ(a->getType(), "up");
+    EXPECT_EQ(board.getCursorTile(), a);
+
+    while (board.redo())
+        ;
+    EXPECT_EQ(board.stateHash(), end);
+    EXPECT_EQ(board.getTile(1, 0), nullptr);
+    EXPECT_EQ(a->getColor(), "blue");
+
+    // A new change drops what could be redone.
+    board.undo();
+    board.rotateTile(a, CLOCKWISE);
+    EXPECT_FALSE(board.canRedo());
+}
+
+TEST(board_test, JournalCapacity) {
+    Board board{"board", 3, 1};
+    for (int x = 0; x < 3; ++x)
+        board.add(std::make_shared<Tile>(std::to_string(x), x, x, 0, "red",
+                                         "empty", false));
+    board.setJournalCapacity(2);
+    board.setCursorTile(board.getTile(0, 0));
+    board.moveCursor(RIGHT);
+    board.moveCursor(RIGHT);
+
+    EXPECT_TRUE(board.undo());
+    EXPECT_TRUE(board.undo());
+    EXPECT_FALSE(board.undo());
+    EXPECT_EQ(board.getCursorTile(), board.getTile(0, 0));
+
+    board.setJournalCapacity(0);
+    board.moveCursor(RIGHT);
+    EXPECT_FALSE(board.canUndo());
+}
+
+TEST(board_test, Snapshot) {
+    Board board{"board", 2, 1};
+    board.add(std::make_shared<Tile>("a", 1, 0, 0, "red", "up", false));
+    board.add(std::make_shared<Tile>("b", 2, 1, 0, "red", "empty", false));
+    board.add(std::make_shared<Gate>(board.getTile("a"), board.getTile("b"),
+                                     "g", "red"));
+    board.setCursorTile(board.getTile("a"));
+    std::uint64_t start = board.stateHash();
+
+    Board branch = board.snapshot();
+    EXPECT_EQ(branch.stateHash(), start);
+
+    TilePtr a = branch.getTile("a");
+    branch.rotateTiles("red", CLOCKWISE);
+    branch.toggleGate(branch.getGate("g"));
+    branch.remove(branch.getTile("b"));
+    EXPECT_EQ(branch.getTile("a")->getType(), "right");
+    EXPECT_EQ(branch.getTile("b"), nullptr);
+    EXPECT_TRUE(branch.getGate("g")->isActive());
+
+    // The original board is untouched, including the shared tile objects.
+    EXPECT_EQ(board.stateHash(), start);
+    EXPECT_EQ(a->getType(), "up");
+    EXPECT_EQ(board.getTile("a")->getType(), "up");
+    EXPECT_NE(board.getTile("b"), nullptr);
+    EXPECT_FALSE(board.getGate("g")->isActive());
+
+    // And it still diverges without touching the branch.
+    std::uint64_t branched = branch.stateHash();
+    board.moveCursor(RIGHT);
+    board.rotateTile(a, COUNTER_CLOCKWISE);
+    EXPECT_EQ(branch.stateHash(), branched);
+    EXPECT_EQ(branch.getTile("a")->getType(), "right");
+    EXPECT_EQ(board.getTile("a")->getType(), "left");
+
+    EXPECT_TRUE(branch.undo());
+    EXPECT_EQ(branch.getTile(1, 0)->getName(), "b");
+}
+
+TEST(board_test, Assign) {
+    std::vector<Tile> tiles;
+    Board added{"board", 3, 2};
+    for (int y = 0; y < 2; ++y) {
+        for (int x = 0; x < 3; ++x) {
+            std::string name = std::to_string(y * 3 + x);
+            tiles.emplace_back(name, y * 3 + x, x, y, "red", "up", false);
+            added.add(std::make_shared<Tile>(tiles.back()));
+        }
+    }
+    std::vector<Gate> gates;
+    gates.emplace_back(added.getTile(0, 0), added.getTile(1, 0), "g", "red");
+    added.add(std::make_shared<Gate>(gates.back()));
+
+    Board board{"board", 3, 2};
+    board.assign(tiles, gates);
+    EXPECT_TRUE(board.full());
+    EXPECT_EQ(board.getTile("4"), board.getTile(1, 1));
+    EXPECT_EQ(board.getGate(board.getTile(1, 0), LEFT), board.getGate("g"));
+    EXPECT_EQ(board.getGate("g")->getTile1(), board.getTile(0, 0));
+    EXPECT_EQ(board.getGate("g")->getTile2(), board.getTile(1, 0));
+    EXPECT_EQ(board.stateHash(), added.stateHash());
+
+    board.rotateTiles("red", CLOCKWISE);
+    added.rotateTiles("red", CLOCKWISE);
+    EXPECT_EQ(board.stateHash(), added.stateHash());
+
+    // Invalid input leaves the board as it was.
+    tiles.push_back(tiles.front());
+    EXPECT_THROW(board.assign(tiles, gates), DuplicateTilesException);
+    EXPECT_EQ(board.stateHash(), added.stateHash());
+
+    // So does a gate onto a cell that the new tiles leave empty.
+    tiles.pop_back();
+    tiles.erase(tiles.begin() + 1);
+    EXPECT_THROW(board.assign(tiles, gates), InvalidGateException);
+    EXPECT_EQ(board.stateHash(), added.stateHash());
+    EXPECT_EQ(board.getGate("g")->getTile2(), board.getTile(1, 0));
+}
+
+TEST(board_test, Handles) {
+    Board board{"board", 2, 1};
+    board.add(std::make_shared<Tile>("a", 1, 0, 0, "red", "up", false));
+    board.add(std::make_shared<Tile>("b", 2, 1, 0, "red", "empty", false));
+    board.add(std::make_shared<Gate>(board.getTile("a"), board.getTile("b"),
+                                     "g", "red"));
+
+    TileHandle a = board.getTileHandle("a");
+    TileHandle b = board.getTileHandle(a, RIGHT);
+    GateHandle g = board.getGateHandle(b, LEFT);
+    EXPECT_EQ(board.getTileHandle(0, 0), a);
+    EXPECT_EQ(board.getGateHandle("g"), g);
+    EXPECT_TRUE(board.getTileHandle(a, LEFT).isNull());
+    EXPECT_EQ(board.getTile(b)->getName(), "b");
+
+    board.rotateTile(a, CLOCKWISE);
+    board.toggleGate(g);
+    board.setCursorTile(b);
+    EXPECT_EQ(board.getTile(a)->getType(), "right");
+    TileType type;
+    EXPECT_TRUE(board.getTileType(a, type));
+    EXPECT_EQ(type, TileType::RIGHT);
+    EXPECT_TRUE(board.getGate(g)->isActive());
+    EXPECT_EQ(board.getCursorHandle(), b);
+
+    // Removing a tile makes its handle stale, even once the
+    // cell is filled again.
+    board.remove(g);
+    board.remove(b);
+    EXPECT_FALSE(board.valid(g));
+    EXPECT_FALSE(board.valid(b));
+    board.add(std::make_shared<Tile>("c", 3, 1, 0, "red", "empty", false));
+    EXPECT_FALSE(board.valid(b));
+    EXPECT_EQ(board.getTile(b), nullptr);
+    EXPECT_THROW(board.remove(b), InvalidTileException);
+    EXPECT_TRUE(board.valid(board.getTileHandle(1, 0)));
+
+    // Handles stay stale long after an 8-bit generation would wrap.
+    board.add(std::make_shared<Gate>(board.getTile("a"), board.getTile("c"),
+                                     "h", "red"));
+    TileHandle c = board.getTileHandle("c");
+    GateHandle h = board.getGateHandle("h");
+    for (int k = 0; k < 1000; ++k) {
+        board.remove(board.getGateHandle("h"));
+        board.remove(board.getTileHandle("c"));
+        board.add(std::make_shared<Tile>("c", 3, 1, 0, "red", "empty", false));
+        board.add(std::make_shared<Gate>(board.getTile("a"),
+                                         board.getTile("c"), "h", "red"));
+        ASSERT_FALSE(board.valid(c));
+        ASSERT_FALSE(board.valid(h));
+    }
+}
+
+TEST(board_test, ForEachIn) {
+    Board board{"board", 4, 4};
+    for (int y = 0; y < 4; ++y)
+        for (int x = 0; x < 4; ++x)
+            if (x != 2 || y != 2)
+                board.add(std::make_shared<Tile>(
+                    "t" + std::to_string(x) + std::to_string(y),
+                    y * 4 + x + 1, x, y, "red", "empty", false));
+
+    auto gate = [&](int x1, int y1, int x2, int y2, const std::string &name) {
+        board.add(std::make_shared<Gate>(board.getTile(x1, y1),
+                                         board.getTile(x2, y2), name, "red"));
+    };
+    gate(0, 1, 1, 1, "left");   // Enters the rectangle from the left.
+    gate(1, 0, 1, 1, "below");  // Enters the rectangle from below.
+    gate(1, 1, 2, 1, "inside"); // Both tiles inside.
+    gate(2, 1, 3, 1, "right");  // Leaves the rectangle to the right.
+    gate(3, 3, 3, 2, "away");   // Both tiles outside.
+
+    std::vector<std::string> tiles, gates;
+    board.forEachTileIn(1, 1, 2, 3, [&](const TilePtr &t) {
+        tiles.push_back(t->getName());
+    });
+    board.forEachGateIn(1, 1, 2, 3, [&](const GatePtr &g) {
+        gates.push_back(g->getName());
+    });
+    std::sort(gates.begin(), gates.end());
+
+    EXPECT_EQ(tiles, (std::vector<std::string>{"t11", "t21", "t12", "t13",
+                                               "t23"}));
+    EXPECT_EQ(gates, (std::vector<std::string>{"below", "inside", "left",
+                                               "right"}));
+
+    // Rectangles are clipped to the board.
+    int count = 0;
+    board.forEachTileIn(-5, -5, 100, 0, [&](const TilePtr &) { ++count; });
+    EXPECT_EQ(count, 4);
+    board.forEachTileIn(5, 0, 9, 3, [&](const TilePtr &) { ++count; });
+    EXPECT_EQ(count, 4);
+}
+
+TEST(board_test, SparseChunks) {
+    Board board{"board", 4000, 3000};
+    EXPECT_EQ(board.allocatedChunks(), 0);
+    EXPECT_TRUE(board.empty());
+    EXPECT_EQ(board.getTile(1234, 2345), nullptr);
+
+    std::vector<std::array<int, 4>> dirty;
+    auto collect = [&](int x0, int y0, int x1, int y1) {
+        dirty.push_back({x0, y0, x1, y1});
+    };
+
+    // A new board is dirty everywhere, down to the clipped last chunk.
+    board.forEachDirtyChunk(collect);
+    EXPECT_EQ(dirty.size(), 250u * 188u);
+    EXPECT_EQ(dirty.back(), (std::array<int, 4>{3984, 2992, 3999, 2999}));
+
+    board.clearDirtyChunks();
+    dirty.clear();
+    board.add(std::make_shared<Tile>("a", 1, 500, 700, "red", "up", false));
+    board.add(std::make_shared<Tile>("b", 2, 501, 700, "red", "up", false));
+    EXPECT_EQ(board.allocatedChunks(), 1);
+    EXPECT_EQ(board.getTile(501, 700)->getName(), "b");
+    EXPECT_FALSE(board.empty());
+    EXPECT_FALSE(board.full());
+
+    board.forEachDirtyChunk(collect);
+    EXPECT_EQ(dirty, (std::vector<std::array<int, 4>>{{496, 688, 511, 703}}));
+
+    // Snapshots share the dirty flags until one of them changes.
+    board.clearDirtyChunks();
+    Board branch = board.snapshot();
+    branch.rotateTile(branch.getTile("a"), CLOCKWISE);
+    dirty.clear();
+    board.forEachDirtyChunk(collect);
+    EXPECT_TRUE(dirty.empty());
+    branch.forEachDirtyChunk(collect);
+    EXPECT_EQ(dirty.size(), 1u);
+
+    // Clearing while the flags are shared leaves the snapshot's alone.
+    board.add(std::make_shared<Tile>("c", 3, 2000, 2000, "red", "up", false));
+    Board shared = board.snapshot();
+    board.clearDirtyChunks();
+    dirty.clear();
+    board.forEachDirtyChunk(collect);
+    EXPECT_TRUE(dirty.empty());
+    shared.forEachDirtyChunk(collect);
+    EXPECT_EQ(dirty,
+              (std::vector<std::array<int, 4>>{{2000, 2000, 2015, 2015}}));
+}
+
+TEST(board_test, Neighbors) {
+    Board board{"board", 3, 2};
+    board.add(std::make_shared<Tile>("a", 1, 0, 0, "none", "empty", false));
+    board.add(std::make_shared<Tile>("b", 2, 1, 0, "none", "empty", false));
+    board.add(
+        std::make_shared<Tile>("c", 3, 2, 0, "none", "collision", false));
+    board.add(std::make_shared<Tile>("d", 4, 1, 1, "none", "empty", false));
+    board.add(std::make_shared<Gate>(board.getTile("a"), board.getTile("b"),
+                                     "g", "red", true));
+
+    TileNeighbors n;
+    ASSERT_TRUE(board.getNeighbors(board.getTileHandle("b"), n));
+    EXPECT_EQ(n.tiles[LEFT], board.getTileHandle("a"));
+    EXPECT_EQ(n.tiles[RIGHT], board.getTileHandle("c"));
+    EXPECT_EQ(n.tiles[UP], board.getTileHandle("d"));
+    EXPECT_TRUE(n.tiles[DOWN].isNull());
+    EXPECT_EQ(n.gates[LEFT], board.getGateHandle("g"));
+    EXPECT_EQ(n.gated, 1 << LEFT);
+    EXPECT_EQ(n.active, 1 << LEFT);
+    EXPECT_EQ(n.open, 1 << UP);
+
+    board.remove(board.getTile("d"));
+    EXPECT_EQ(board.getTile(board.getTile("b"), UP), nullptr);
+    EXPECT_FALSE(board.getNeighbors(TileHandle{}, n));
+}
+
+TEST(board_test, NeighborsAcrossChunks) {
+    // Churn tiles across the corners of four chunks and check every
+    // neighbor query against a lookup by coordinates.
+    Board board{"board", 40, 40};
+    std::mt19937 rng{9};
+    for (int k = 0; k < 3000; ++k) {
+        int x = 12 + rng() % 8, y = 12 + rng() % 8;
+        if (TilePtr t = board.getTile(x, y))
+            board.remove(t);
+        else
+            board.add(std::make_shared<Tile>("t" + std::to_string(k), k + 1,
+                                             x, y, "none", "empty", false));
+    }
+    board.setLength(41);
+
+    for (int y = 11; y < 21; ++y) {
+        for (int x = 11; x < 21; ++x) {
+            TilePtr t = board.getTile(x, y);
+            if (t == nullptr)
+                continue;
+            for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+                int dx = (d == RIGHT) - (d == LEFT);
+                int dy = (d == UP) - (d == DOWN);
+                EXPECT_EQ(board.getTile(t, d), board.getTile(x + dx, y + dy));
+                EXPECT_EQ(board.getTileHandle(board.getTileHandle(x, y), d),
+                          board.getTileHandle(x + dx, y + dy));
+            }
+        }
+    }
+}
+
+TEST(board_test, DrainChanges) {
+    Board board{"board", 3, 1};
+    board.add(std::make_shared<Tile>("a", 1, 0, 0, "red", "up", false));
+    board.add(std::make_shared<Tile>("b", 2, 1, 0, "red", "empty", false));
+    board.add(std::make_shared<Tile>("c", 3, 2, 0, "blue", "left", false));
+    board.add(std::make_shared<Gate>(board.getTile("b"), board.getTile("c"),
+                                     "g", "red"));
+    board.setCursorTile(board.getTile("a"));
+
+    // A new board has to be scanned in full once.
+    BoardChanges changes = board.drainChanges();
+    EXPECT_TRUE(changes.reset);
+    EXPECT_TRUE(changes.records.empty());
+    EXPECT_EQ(changes.version, board.getVersion());
+
+    std::uint64_t version = board.getVersion();
+    board.moveCursor(RIGHT);
+    board.toggleGate(board.getGate("g"));
+    board.rotateTiles("red", CLOCKWISE);
+    EXPECT_GT(board.getVersion(), version);
+
+    // One record per cell, in order of its first change.
+    changes = board.drainChanges();
+    EXPECT_FALSE(changes.reset);
+    ASSERT_EQ(changes.records.size(), 2u);
+    EXPECT_EQ(changes.records[0].x, 0);
+    EXPECT_EQ(changes.records[0].changed,
+              BoardChangeRecord::CURSOR | BoardChangeRecord::TILE);
+    EXPECT_EQ(changes.records[1].x, 1);
+    EXPECT_EQ(changes.records[1].changed,
+              BoardChangeRecord::CURSOR | BoardChangeRecord::GATE_RIGHT);
+
+    version = board.getVersion();
+    EXPECT_TRUE(board.drainChanges().records.empty());
+    EXPECT_EQ(board.getVersion(), version);
+
+    // Undo is a change like any other.
+    ASSERT_TRUE(board.undo());
+    changes = board.drainChanges();
+    ASSERT_EQ(changes.records.size(), 1u);
+    EXPECT_EQ(changes.records[0].x, 0);
+    EXPECT_EQ(changes.records[0].changed, BoardChangeRecord::TILE);
+
+    board.remove(board.getGate("g"));
+    board.remove(board.getTile("c"));
+    changes = board.drainChanges();
+    ASSERT_EQ(changes.records.size(), 2u);
+    EXPECT_EQ(changes.records[0].changed, BoardChangeRecord::GATE_RIGHT);
+    EXPECT_EQ(changes.records[1].x, 2);
+    EXPECT_EQ(changes.records[1].changed, BoardChangeRecord::TILE);
+
+    // A snapshot keeps the version but starts over with a reset.
+    Board branch = board.snapshot();
+    EXPECT_EQ(branch.getVersion(), board.getVersion());
+    EXPECT_TRUE(branch.drainChanges().reset);
+    EXPECT_FALSE(board.drainChanges().reset);
+
+    board.setLength(4);
+    EXPECT_TRUE(board.drainChanges().reset);
+}
+
+TEST(board_test, DrainChangesOverflow) {
+    Board board{"board", 16, 16};
+    board.drainChanges();
+
+    // Changing every cell is reported as a reset rather than records.
+    for (int y = 0; y < 16; ++y)
+        for (int x = 0; x < 16; ++x)
+            board.add(std::make_shared<Tile>(
+                "t" + std::to_string(y * 16 + x), y * 16 + x + 1, x, y,
+                "red", "up", false));
+
+    BoardChanges changes = board.drainChanges();
+    EXPECT_TRUE(changes.reset);
+    EXPECT_TRUE(changes.records.empty());
+
+    board.rotateTile(board.getTile(3, 4), CLOCKWISE);
+    changes = board.drainChanges();
+    EXPECT_FALSE(changes.reset);
+    ASSERT_EQ(changes.records.size(), 1u);
+    EXPECT_EQ(changes.records[0].y, 4);
+}
+
+TEST(board_test, Reachable) {
+    Board board{"board", 4, 1};
+    for (int x = 0; x < 4; ++x)
+        board.add(std::make_shared<Tile>(std::string(1, 'a' + x), x + 1, x,
+                                         0, "none", "empty", false));
+    board.add(std::make_shared<Gate>(board.getTile("b"), board.getTile("c"),
+                                     "g", "red", true));
+    TileHandle a = board.getTileHandle("a"), b = board.getTileHandle("b");
+    TileHandle c = board.getTileHandle("c"), d = board.getTileHandle("d");
+
+    EXPECT_TRUE(board.reachable(a, b));
+    EXPECT_FALSE(board.reachable(a, c));
+    EXPECT_EQ(board.componentOf(c), board.componentOf(d));
+    EXPECT_NE(board.componentOf(a), board.componentOf(d));
+
+    board.toggleGate(board.getGate("g"));
+    EXPECT_TRUE(board.reachable(a, d));
+    board.toggleGate(board.getGate("g"));
+    EXPECT_FALSE(board.reachable(a, d));
+    ASSERT_TRUE(board.undo());
+    EXPECT_TRUE(board.reachable(d, a));
+
+    // Collision tiles belong to no component and block the way, but
+    // the cursor can still step off one.
+    board.setTileType(board.getTile("b"), "collision");
+    EXPECT_EQ(board.componentOf(b), -1);
+    EXPECT_FALSE(board.reachable(a, c));
+    EXPECT_FALSE(board.reachable(a, b));
+    EXPECT_TRUE(board.reachable(b, d));
+    board.setTileType(board.getTile("b"), "empty");
+    EXPECT_TRUE(board.reachable(a, c));
+
+    board.remove(board.getTile("c"));
+    EXPECT_FALSE(board.reachable(a, d));
+    EXPECT_FALSE(board.reachable(a, c));
+    ASSERT_TRUE(board.undo());
+    EXPECT_TRUE(board.reachable(a, board.getTileHandle("d")));
+
+    // Snapshots build their own index.
+    Board branch = board.snapshot();
+    branch.remove(branch.getTile("b"));
+    EXPECT_FALSE(branch.reachable(branch.getTileHandle("a"),
+                                  branch.getTileHandle("d")));
+    EXPECT_TRUE(board.reachable(board.getTileHandle("a"),
+                                board.getTileHandle("d")));
+}
+
+TEST(board_test, ReachableMatchesFloodFill) {
+    constexpr int SIZE = 40;
+    Board board{"board", SIZE, SIZE};
+    std::mt19937 rng{5};
+    for (int y = 0; y < SIZE; ++y)
+        for (int x = 0; x < SIZE; ++x)
+            board.add(std::make_shared<Tile>(
+                "t" + std::to_string(y * SIZE + x), y * SIZE + x + 1, x, y,
+                "none", rng() % 5 ? "empty" : "collision", false));
+
+    std::vector<GatePtr> gates;
+    for (int k = 0; k < 400; ++k) {
+        int x = rng() % (SIZE - 1), y = rng() % SIZE;
+        if (board.getGate(board.getTile(x, y), RIGHT) != nullptr)
+            continue;
+        gates.push_back(std::make_shared<Gate>(
+            board.getTile(x, y), board.getTile(x + 1, y),
+            "g" + std::to_string(k), "red", rng() % 2 == 0));
+        board.add(gates.back());
+    }
+
+    auto flood = [&](const TileHandle &from) {
+        std::vector<TileHandle> seen{from}, queue{from};
+        while (!queue.empty()) {
+            TileHandle h = queue.back();
+            queue.pop_back();
+            TileNeighbors n;
+            board.getNeighbors(h, n);
+            for (Direction d : {UP, DOWN, LEFT, RIGHT}) {
+                if (!(n.open & (1 << d)) ||
+                    std::find(seen.begin(), seen.end(), n.tiles[d]) !=
+                        seen.end())
+                    continue;
+                seen.push_back(n.tiles[d]);
+                queue.push_back(n.tiles[d]);
+            }
+        }
+        return seen;
+    };
+
+    for (int round = 0; round < 60; ++round) {
+        for (int k = 0; k < 10; ++k) {
+            int x = rng() % SIZE, y = rng() % SIZE;
+            if (rng() % 2) {
+                GatePtr g = board.getGate(gates[rng() % gates.size()]
+                                              ->getName());
+                if (g != nullptr)
+                    board.toggleGate(g);
+            } else {
+                board.setTileType(board.getTile(x, y),
+                                  rng() % 4 ? "empty" : "collision");
+            }
+        }
+
+        TileHandle from = board.getTileHandle(rng() % SIZE, rng() % SIZE);
+        std::vector<TileHandle> seen = flood(from);
+        for (int k = 0; k < 40; ++k) {
+            TileHandle to = board.getTileHandle(rng() % SIZE, rng() % SIZE);
+            bool expected =
+                std::find(seen.begin(), seen.end(), to) != seen.end();
+            EXPECT_EQ(board.reachable(from, to), expected);
+        }
+    }
+}
+
+TEST(board_test, Apply) {
+    Board board{"board", 4, 1};
+    for (int x = 0; x < 4; ++x)
+        board.add(std::make_shared<Tile>(std::string(1, 'a' + x), x + 1, x,
+                                         0, "red", "up", false));
+    board.add(std::make_shared<Gate>(board.getTile("b"), board.getTile("c"),
+                                     "g", "red", true));
+    board.setCursorTile(board.getTile("a"));
+    Board expected = board.snapshot();
+
+    ColorID red = ColorRegistry::intern("red");
+    GateHandle g = board.getGateHandle("g");
+    std::vector<Command> commands{
+        Command::move(RIGHT),
+        Command::move(RIGHT), // Blocked by the gate
+        Command::toggle(g),
+        Command::move(RIGHT),
+        Command::move(UP), // Off the board
+        Command::rotate(red, CLOCKWISE),
+        Command::rotate(red, CLOCKWISE),
+        Command::rotate(red, CLOCKWISE),
+        Command{CommandType::ROTATE_TILES, 7, red},
+        Command{CommandType::MOVE_CURSOR, 9},
+        Command::toggle(GateHandle{})};
+
+    std::vector<CommandResult> results = board.apply(commands);
+    using R = CommandResult;
+    EXPECT_EQ(results, (std::vector<R>{R::OK, R::BLOCKED, R::OK, R::OK,
+                                       R::BLOCKED, R::OK, R::OK, R::OK,
+                                       R::INVALID, R::INVALID, R::INVALID}));
+
+    // The same as one call per command.
+    expected.moveCursor(RIGHT);
+    expected.toggleGate(expected.getGate("g"));
+    expected.moveCursor(RIGHT);
+    for (int k = 0; k < 3; ++k)
+        expected.rotateTiles("red", CLOCKWISE);
+    EXPECT_EQ(board.stateHash(), expected.stateHash());
+    EXPECT_EQ(board.getTile("d")->getType(), "left");
+    EXPECT_EQ(board.getCursorTile()->getName(), "c");
+
+    // Each run of moves or rotations was merged into one change.
+    ASSERT_TRUE(board.undo());
+    EXPECT_EQ(board.getTile("d")->getType(), "up");
+    ASSERT_TRUE(board.undo());
+    EXPECT_EQ(board.getCursorTile()->getName(), "b");
+    ASSERT_TRUE(board.redo());
+    EXPECT_EQ(board.getCursorTile()->getName(), "c");
+
+    // Runs that cancel out leave nothing to undo.
+    board.clearJournal();
+    board.apply(std::vector<Command>{Command::rotate(red, CLOCKWISE),
+                                     Command::rotate(red, COUNTER_CLOCKWISE)});
+    board.apply(
+        std::vector<Command>{Command::move(LEFT), Command::move(RIGHT)});
+    EXPECT_FALSE(board.canUndo());
+    EXPECT_EQ(board.getTile("d")->getType(), "up");
+    EXPECT_EQ(board.getCursorTile()->getName(), "c");
+}
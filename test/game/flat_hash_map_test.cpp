@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "utils/flat_hash_map.h"
+using namespace pone;
+
+namespace {
+
+/* Sends every key to the same slot, so that every entry
+ * sits in one probe sequence. */
+struct CollidingHash {
+    std::uint64_t operator()(const int &) const { return 0; }
+};
+
+} // namespace
+
+TEST(flat_hash_map_test, Constructor) {
+    FlatHashMap<int, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(1), map.end());
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_EQ(map.erase(1), 0u);
+}
+
+TEST(flat_hash_map_test, InsertFindErase) {
+    FlatHashMap<std::string, int> map;
+    EXPECT_TRUE(map.emplace("a", 1).second);
+    EXPECT_FALSE(map.emplace("a", 2).second);
+    map["b"] = 3;
+
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.find("a")->second, 1);
+    EXPECT_EQ(map.find(std::string_view{"b"})->second, 3);
+    EXPECT_FALSE(map.contains("c"));
+
+    EXPECT_EQ(map.erase("a"), 1u);
+    EXPECT_EQ(map.erase("a"), 0u);
+    EXPECT_EQ(map.find("a"), map.end());
+    EXPECT_EQ(map.size(), 1u);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains("b"));
+}
+
+TEST(flat_hash_map_test, EraseKeepsProbeSequences) {
+    FlatHashMap<int, int, CollidingHash> map;
+    for (int i = 0; i < 12; ++i)
+        map[i] = i;
+
+    // Removing entries from the middle of one long probe sequence,
+    // which wraps around the end of the table.
+    for (int i = 0; i < 12; i += 3)
+        EXPECT_EQ(map.erase(i), 1u);
+
+    for (int i = 0; i < 12; ++i)
+        EXPECT_EQ(map.contains(i), i % 3 != 0);
+}
+
+TEST(flat_hash_map_test, MatchesUnorderedMap) {
+    std::mt19937 rng{3};
+    FlatHashMap<int, int> map;
+    std::unordered_map<int, int> expected;
+
+    for (int k = 0; k < 20000; ++k) {
+        int key = rng() % 512;
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(map.erase(key), expected.erase(key));
+        } else {
+            map[key] = k;
+            expected[key] = k;
+        }
+    }
+
+    EXPECT_EQ(map.size(), expected.size());
+    std::size_t count = 0;
+    for (const auto &[key, value] : map) {
+        EXPECT_EQ(expected.at(key), value);
+        ++count;
+    }
+    EXPECT_EQ(count, expected.size());
+}
@@ -0,0 +1,98 @@
+/*   Created:  2026-10-17
+ *   Modified: 2026-10-17
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "game/pone_publisher.hpp"
+using namespace pone;
+
+namespace {
+
+Board makeRow(const int &length) {
+    Board board{"board", length, 1};
+    for (int x = 0; x < length; ++x)
+        board.add(std::make_shared<Tile>("t" + std::to_string(x), x + 1, x, 0,
+                                         "red", x ? "up" : "empty", false));
+    board.setCursorTile(board.getTile(0, 0));
+    return board;
+}
+
+} // namespace
+
+TEST(publisher_test, PublishAndRead) {
+    Board board = makeRow(3);
+    BoardPublisher publisher{board};
+    BoardView first = publisher.read();
+    EXPECT_EQ(publisher.publishes(), 1u);
+    EXPECT_EQ(first->stateHash(), board.stateHash());
+
+    // Edits stay private to the writer until they are published.
+    board.moveCursor(RIGHT);
+    board.rotateTiles("red", CLOCKWISE);
+    EXPECT_EQ(publisher.read(), first);
+
+    BoardView second = publisher.publish(board);
+    EXPECT_EQ(publisher.read(), second);
+    EXPECT_EQ(publisher.publishes(), 2u);
+    EXPECT_EQ(second->getCursorTile()->getX(), 1);
+    EXPECT_EQ(second->getTile(2, 0)->getType(), "right");
+
+    // Views already handed out are never changed.
+    board.moveCursor(RIGHT);
+    EXPECT_EQ(first->getCursorTile()->getX(), 0);
+    EXPECT_EQ(first->getTile(2, 0)->getType(), "up");
+    EXPECT_EQ(second->getCursorTile()->getX(), 1);
+
+    // A reader may branch off a view and edit the branch.
+    Board branch = *second;
+    branch.moveCursor(LEFT);
+    EXPECT_EQ(branch.getCursorTile()->getX(), 0);
+    EXPECT_EQ(second->getCursorTile()->getX(), 1);
+}
+
+TEST(publisher_test, ConcurrentReaders) {
+    constexpr int LENGTH = 64, ROUNDS = 2000, READERS = 3;
+    Board board = makeRow(LENGTH);
+    BoardPublisher publisher{board};
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+
+    // Every published board has its cursor on a tile and a version
+    // no older than the last one the same reader saw.
+    auto read = [&] {
+        BoardReader reader{publisher};
+        std::uint64_t version = 0;
+        while (!done.load()) {
+            const Board &view = reader.current();
+            TilePtr cursor = view.getCursorTile();
+            if (cursor == nullptr || !cursor->isCursor() ||
+                view.getVersion() < version)
+                ++failures;
+            version = view.getVersion();
+            Board branch = view;
+            branch.rotateTiles("red", CLOCKWISE);
+        }
+    };
+
+    std::vector<std::thread> readers;
+    for (int k = 0; k < READERS; ++k)
+        readers.emplace_back(read);
+
+    for (int k = 0; k < ROUNDS; ++k) {
+        board.moveCursor((k / (LENGTH - 1)) % 2 ? LEFT : RIGHT);
+        board.rotateTiles("red", COUNTER_CLOCKWISE);
+        publisher.publish(board);
+    }
+    done = true;
+    for (std::thread &t : readers)
+        t.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(publisher.read()->stateHash(), board.stateHash());
+    EXPECT_EQ(BoardReader{publisher}.current().stateHash(),
+              board.stateHash());
+}
@@ -1,4 +1,34 @@
 #include <gtest/gtest.h>
 
+#include "game/pone_except.hpp"
 #include "game/pone_tile.hpp"
 using namespace pone;
+
+TEST(tile_test, TypeConversion) {
+    Tile t{"a", 1, 0, 0, "none", "gswitch", false};
+
+    EXPECT_EQ(t.getTileType(), TileType::GATE_SWITCH);
+    EXPECT_EQ(t.getType(), "gswitch");
+    EXPECT_TRUE(t.isGateSwitch());
+    EXPECT_TRUE(t.isType("gswitch"));
+    EXPECT_FALSE(t.isType("not-a-type"));
+
+    t.setType("left");
+    EXPECT_TRUE(t.isDirection());
+    EXPECT_EQ(tileTypeName(t.getTileType()), "left");
+    EXPECT_THROW(t.setType("sideways"), InvalidValueException);
+}
+
+TEST(tile_test, InternedColor) {
+    Tile t1{"a", 1, 0, 0, "magenta", "empty", false};
+    Tile t2{"b", 2, 1, 0, "magenta", "empty", false};
+    Tile t3;
+
+    EXPECT_EQ(t1.getColorID(), t2.getColorID());
+    EXPECT_EQ(t1.getColor(), "magenta");
+    EXPECT_EQ(t3.getColorID(), NO_COLOR);
+    EXPECT_EQ(t3.getColor(), "none");
+
+    t3.setColor("magenta");
+    EXPECT_EQ(t3.getColorID(), t1.getColorID());
+}